@@ -28,6 +28,8 @@
 #
 # Created: fall   2017 Harrison B. Prosper
 # Updated: 04-Dec-2017 HBP add creation vertex (x,y,z) of particles.
+#          16-Oct-2026 HBP add chunked mode (--chunk), using the compiled
+#                      parser through python/hepmcpandas.py
 # -----------------------------------------------------------------------
 import os, sys
 try:
@@ -309,21 +311,63 @@ class hepmc2pandas:
         for ii in range(self.event['Event_numberP'][-1]):
             print("%4d\t%s" % (ii, self.__str__(ii)))
 # -----------------------------------------------------------------------    
+USAGE = '''
+    Usage:
+        ./hepmc2pandas.py [options] <HepMC-file> [output pickle file = <name>.pkl]
+
+    Options:
+        -c, --chunk N    write the events N at a time to <name>_0000.pkl,
+                         <name>_0001.pkl, ..., each holding the DataFrames
+                         (events, particles), using the compiled parser
+        -t, --threads N  parse on N threads in chunked mode (default 1)
+        -k, --kinematics add the columns Particle_pt, Particle_eta,
+                         Particle_phi and Particle_rapidity in chunked mode
+        '''
+
 def main():
     argv = sys.argv[1:]
-    argc = len(argv)
+    chunk    = 0
+    nthreads = 1
+    kinematics = False
+    args = []
+    while len(argv) > 0:
+        arg = argv.pop(0)
+        if arg in ['-c', '--chunk'] and len(argv) > 0:
+            chunk = int(argv.pop(0))
+        elif arg in ['-t', '--threads'] and len(argv) > 0:
+            nthreads = int(argv.pop(0))
+        elif arg in ['-k', '--kinematics']:
+            kinematics = True
+        elif arg[:1] == '-' and arg != '-':
+            sys.exit(USAGE)
+        else:
+            args.append(arg)
+    argc = len(args)
     if argc < 1:
-        sys.exit('''
-    Usage:
-        ./hepmc2pandas.py <HepMC-file> [output pickle file = <name>.pkl]
-        ''')
+        sys.exit(USAGE)
 
-    filename = argv[0]
+    filename = args[0]
     if argc > 1:
-        outfilename = argv[1]
+        outfilename = args[1]
     else:
         outfilename = '%s.pkl' % nameonly(filename)
 
+    if chunk > 0:
+        # bounded memory: each chunk is written, then dropped
+        from hepmcpandas import hepmcChunks
+        stem = outfilename
+        if stem[-4:] == '.pkl': stem = stem[:-4]
+        chunks = hepmcChunks(filename, chunk, nthreads, kinematics)
+        print("HepMC version: %s" % chunks.version)
+        ii = 0
+        for k, (events, particles) in enumerate(chunks):
+            name = '%s_%4.4d.pkl' % (stem, k)
+            print("=> saving %d events to file: %s" % (len(events), name))
+            pd.to_pickle((events, particles), name)
+            ii += len(events)
+        print("=> done! %d events" % ii)
+        return
+
     stream = hepmc2pandas(filename)
 
     ii = 0
@@ -31,6 +31,8 @@
 # Updated: 04-Dec-2017 HBP add creation vertex (x,y,z) of particles.
 #          15-Apr-2019 HBP test that ROOT can be imported
 #          31-Jan-2020 HBP make compatible with Python 3
+#          16-Oct-2026 HBP add checkpoints, from which a conversion can
+#                          be resumed
 # -----------------------------------------------------------------------
 import os, sys
 try:
@@ -51,7 +53,8 @@ debug = 0
 
 class hepmc2root:
     
-    def __init__(self, filename, outfilename=None, treename=TREENAME, complevel=2):
+    def __init__(self, filename, outfilename=None, treename=TREENAME, complevel=2,
+                     resume=False):
 
         # check that file exists
         
@@ -59,7 +62,9 @@ class hepmc2root:
             sys.exit("** hepmc2root.py: can't open file %s" % \
                          filename)
         self.inp = open(filename)
-        inp = self.inp
+        self.offset = 0 # byte offset of next line
+        self.lines = self.readlines()
+        inp = self.lines
 
         # get version number of HepMC
         
@@ -90,9 +95,21 @@ class hepmc2root:
         if outfilename == None:
             outfilename = '%s.root' % nameonly(filename)
             
-        self.file = ROOT.TFile(outfilename, "recreate")
-        self.tree = ROOT.TTree(treename, 'created: %s HepMC %s' % \
-                                   (ctime(), version))
+        if resume:
+            # continue the tree saved by the last checkpoint
+            self.file = ROOT.TFile(outfilename, "update")
+            self.tree = self.file.Get(treename)
+            point = None
+            if self.tree:
+                point = self.tree.GetUserInfo().FindObject('checkpoint')
+            if not point:
+                self.file = None # leave the file as it is
+                sys.exit("** hepmc2root.py: no checkpoint in file %s" % \
+                             outfilename)
+        else:
+            self.file = ROOT.TFile(outfilename, "recreate")
+            self.tree = ROOT.TTree(treename, 'created: %s HepMC %s' % \
+                                       (ctime(), version))
 
         # define event struct
         
@@ -141,6 +158,7 @@ class hepmc2root:
         # indices to vertices
         
         self.pvertex = [0]*MAXPART
+        self.truncated = False
         
         # create struct
         
@@ -166,6 +184,14 @@ class hepmc2root:
             else:
                 field = name
                 fmt   = '%s/%s' % (field, T)
+            if resume:
+                b = self.tree.GetBranch(field)
+                if not b:
+                    sys.exit("** hepmc2root.py: no branch %s in file %s" % \
+                                 (field, outfilename))
+                b.SetAddress(ROOT.addressof(self.bag, field))
+                self.branch.append(b)
+                continue
             self.branch.append(self.tree.Branch(field,
                                                 ROOT.addressof(self.bag, field),
                                                     fmt))
@@ -182,9 +208,66 @@ class hepmc2root:
             leafname = leaf.GetName()
             leaftype = leaf.GetTypeName()
             print("%4d\t%-20s\t%s" % (ii+1, bname, leaftype))
-            
+
+        # skip the events converted before the checkpoint
+        
+        if resume:
+            token = str.split(point.GetTitle())
+            offset, event, entries = int(token[1]), int(token[3]), int(token[5])
+            if entries != self.tree.GetEntries():
+                sys.exit("** hepmc2root.py: checkpoint of %d entries, "\
+                             "but %d found" % (entries, self.tree.GetEntries()))
+            self.inp.seek(offset)
+            line = self.inp.readline()
+            if line[:2] != 'E ' and line[:7] != 'HepMC::':
+                sys.exit("** hepmc2root.py: no event at byte %d of %s" % \
+                             (offset, filename))
+            self.inp.seek(offset)
+            self.offset = offset
+            print("resume after event %d (entry %d) at byte %d" % \
+                      (event, entries, offset))
+
     def __del__(self):
+        self.close()
+
+    def readlines(self):
+        # keep track of the byte offset (the file is ASCII)
+        for line in self.inp:
+            self.offset += len(line)
+            yield line
+
+    def checkpoint(self):
+        # save the entries written so far together with the resume point:
+        # the byte offset of the next event, the number of the last event
+        # converted and the number of entries
+        info  = self.tree.GetUserInfo()
+        point = info.FindObject('checkpoint')
+        if point:
+            info.Remove(point)
+            ROOT.SetOwnership(point, True)
+        point = ROOT.TNamed('checkpoint', 'offset %d event %d entries %d' % \
+                                (self.offset, self.bag.Event_number,
+                                     self.tree.GetEntries()))
+        ROOT.SetOwnership(point, False)
+        info.Add(point)
+
+        # from now on, ROOT must not save the tree header by itself
+        self.file.cd()
+        self.tree.SetAutoSave(0)
+        self.tree.AutoSave('SaveSelf;FlushBaskets')
+
+    def close(self):
+        if getattr(self, 'file', None) == None: return
+        # a complete tree has no resume point
+        info  = self.tree.GetUserInfo()
+        point = info.FindObject('checkpoint')
+        if point:
+            info.Remove(point)
+            ROOT.SetOwnership(point, True)
+        self.file.cd()
         self.tree.Write("", ROOT.TObject.kOverwrite)
+        self.file.Close()
+        self.file = None
         
     def __str__(self, index):
         bag = self.bag
@@ -206,7 +289,7 @@ class hepmc2root:
         return rec
 
     def __call__(self):
-        inp = self.inp
+        inp = self.lines
         bag = self.bag
 
         self.event = [] # cache HepMC event in original format
@@ -324,7 +407,12 @@ class hepmc2root:
                                 self.vertex[vbarcode][0] = index
                             else:
                                 self.vertex[vbarcode][1] = index
-                        
+
+                        elif not self.truncated:
+                            self.truncated = True
+                            print("** hepmc2root.py: events with more than "\
+                                  "%d particles are truncated; use the "\
+                                  "compiled converter" % MAXPART)
                         break
                     else:
                         return False
@@ -354,12 +442,29 @@ class hepmc2root:
             print("%4d\t%s" % (ii, self.__str__(ii)))
 # -----------------------------------------------------------------------    
 def main():
-    argv = sys.argv[1:]
+    checkpoint = 0
+    resume = False
+    argv = []
+    args = sys.argv[1:]
+    while len(args) > 0:
+        arg = args.pop(0)
+        if arg == '--checkpoint' and len(args) > 0:
+            checkpoint = int(args.pop(0))
+        elif arg == '--resume':
+            resume = True
+        else:
+            argv.append(arg)
     argc = len(argv)
     if argc < 1:
         sys.exit('''
     Usage:
-        ./hepmc2root.py <HepMC-file> [output root file = <name>.root]
+        ./hepmc2root.py [options] <HepMC-file> [output root file = <name>.root]
+
+    Options:
+        --checkpoint N  every N events, save the events converted so far,
+                        and how far the input has been read, in the output
+        --resume        continue the conversion from the last checkpoint
+                        in the output file
         ''')
 
     filename = argv[0]
@@ -368,13 +473,16 @@ def main():
     else:
         outfilename = '%s.root' % nameonly(filename)
 
-    stream = hepmc2root(filename, outfilename)
+    stream = hepmc2root(filename, outfilename, resume=resume)
 
-    ii = 0
+    ii = stream.tree.GetEntries()
     while stream():
         if ii % 1000 == 0:
             print(ii)
         ii += 1
+        if checkpoint > 0 and ii % checkpoint == 0:
+            stream.checkpoint()
+    stream.close()
 # -----------------------------------------------------------------------
 try:
     main()
@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------
+# File: hepmcbench.py
+# Description: benchmark the conversion of HepMC files. Synthetic HepMC2
+#              files are written by converter/hepmcgen, once, with given
+#              numbers of events, particles per event, outgoing particles
+#              per vertex and optional C and F records, and each is read by
+#              the compiled converter (hepmc2root), the compiled filter
+#              (hepmcfilter) and the chunked pandas conversion
+#              (hepmc2pandas.py --chunk). For each the events/s, the input
+#              MB/s and the peak memory (RSS) are reported and, with
+#              --baseline, compared with those of an earlier run.
+#
+#              make bench
+#
+# Created: 16-Oct-2026 HBP
+# -----------------------------------------------------------------------
+import os, sys, json, time, subprocess
+# -----------------------------------------------------------------------
+# name: (events, particles per event, fanout, records)
+CASES = [('small',  10000, '10:100',   3,  'CF'),
+         ('medium',   500, '1000',     3,  'CF'),
+         ('wide',     500, '1000',     10, ''),
+         ('large',      5, '100000',   3,  'CF'),
+         ('mixed',   1000, '10:10000', 4,  'C')]
+
+PATHS = ['converter', 'filter', 'pandas']
+
+# the Z boson of the synthetic events decays to mu+mu- in half of them
+PATTERN = ['23', '13', '-13']
+
+MB = 1024.0 * 1024.0
+
+def nameonly(s):
+    import posixpath
+    return posixpath.splitext(posixpath.split(s)[1])[0]
+
+def topdir():
+    if 'HEPMC2ROOT_PATH' in os.environ:
+        return os.environ['HEPMC2ROOT_PATH']
+    here = os.path.dirname(os.path.abspath(__file__))
+    return os.path.join(here, '..')
+
+def run(command, logname, env=None):
+    """Run command and return (ok, elapsed seconds, peak RSS in bytes)."""
+    log = open(logname, 'w')
+    t = time.time()
+    proc = subprocess.Popen(command, stdout=log, stderr=subprocess.STDOUT,
+                            env=env)
+    pid, status, usage = os.wait4(proc.pid, 0)
+    elapsed = time.time() - t
+    proc.returncode = status
+    log.close()
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS
+    rss = usage.ru_maxrss
+    if sys.platform != 'darwin': rss *= 1024
+    return (os.WIFEXITED(status) and os.WEXITSTATUS(status) == 0,
+            elapsed, rss)
+
+class benchmark:
+
+    def __init__(self, workdir, nthreads, chunk):
+        self.top = topdir()
+        self.converter = os.path.join(self.top, 'converter')
+        self.workdir = workdir
+        self.nthreads = '%d' % nthreads
+        self.chunk = '%d' % chunk
+        self.results = []
+        if not os.path.exists(workdir):
+            os.makedirs(workdir)
+
+        self.env = dict(os.environ)
+        self.env['HEPMC2ROOT_PATH'] = self.top
+        pythonpath = os.path.join(self.top, 'python')
+        if 'PYTHONPATH' in self.env:
+            pythonpath += os.pathsep + self.env['PYTHONPATH']
+        self.env['PYTHONPATH'] = pythonpath
+
+    def path(self, name):
+        return os.path.join(self.workdir, name)
+
+    def generate(self, case):
+        """Write the synthetic file of a case, unless it already exists."""
+        name, nevents, particles, fanout, records = case
+        filename = self.path('%s_%d_%s_f%d%s.hepmc' % \
+                                 (name, nevents, particles.replace(':', '-'),
+                                      fanout, records and '_' + records))
+        if os.path.exists(filename):
+            return filename
+        command = [os.path.join(self.converter, 'hepmcgen'),
+                   '--events', '%d' % nevents, '--particles', particles,
+                   '--fanout', '%d' % fanout]
+        if records: command += ['--records', records]
+        print('=> generating %s' % filename)
+        # write to a temporary file, so that an interrupted run leaves no
+        # partial file behind
+        ok, elapsed, rss = run(command + [filename + '.tmp'],
+                               self.path('hepmcgen.log'))
+        if not ok:
+            sys.exit('** hepmcbench: hepmcgen failed; see %s' % \
+                         self.path('hepmcgen.log'))
+        os.rename(filename + '.tmp', filename)
+        return filename
+
+    def commands(self, path, filename):
+        """Return command and outputs of a path."""
+        stem = self.path(nameonly(filename) + '_' + path)
+        if path == 'converter':
+            report = stem + '.json'
+            return ([os.path.join(self.converter, 'hepmc2root'),
+                     '--threads', self.nthreads, '--report', report,
+                     filename, stem + '.root'],
+                    [stem + '.root', report])
+        elif path == 'filter':
+            return ([os.path.join(self.converter, 'hepmcfilter'),
+                     '--threads', self.nthreads, '--output',
+                     stem + '.hepmc', filename] + PATTERN,
+                    [stem + '.hepmc'])
+        else:
+            # the chunks are <stem>_0000.pkl, <stem>_0001.pkl, ...
+            return ([sys.executable,
+                     os.path.join(self.top, 'bin', 'hepmc2pandas.py'),
+                     '--chunk', self.chunk, '--threads', self.nthreads,
+                     filename, stem + '.pkl'], [])
+
+    def __call__(self, case, path):
+        filename = self.generate(case)
+        command, outputs = self.commands(path, filename)
+        if not os.path.exists(command[0]) and path != 'pandas':
+            print('** hepmcbench: %s not built, skipping %s' % \
+                      (command[0], path))
+            return
+        stem = self.path(nameonly(filename) + '_' + path)
+        ok, elapsed, rss = run(command, stem + '.log', self.env)
+        if not ok:
+            print('** hepmcbench: %s failed; see %s.log' % (path, stem))
+
+        nevents = case[1]
+        size = os.path.getsize(filename)
+        result = {'case': case[0],
+                  'path': path,
+                  'ok': ok,
+                  'events': nevents,
+                  'bytes': size,
+                  'threads': int(self.nthreads),
+                  'elapsed_seconds': elapsed,
+                  'events_per_second': nevents / elapsed,
+                  'mb_per_second': size / MB / elapsed,
+                  'peak_rss_bytes': rss}
+
+        # the converter also reports the time spent in each stage
+        if path == 'converter' and os.path.exists(stem + '.json'):
+            result['stage_seconds'] = \
+                json.load(open(stem + '.json'))['stage_seconds']
+
+        # remove the outputs, which can be large
+        for name in outputs:
+            if os.path.exists(name): os.remove(name)
+        if path == 'pandas':
+            prefix = os.path.basename(stem) + '_'
+            for name in os.listdir(self.workdir):
+                if name.startswith(prefix) and name.endswith('.pkl'):
+                    os.remove(self.path(name))
+
+        self.results.append(result)
+        self.show(result)
+
+    def show(self, result):
+        line = '%-8s %-10s %8d %8.1f %8.2f %10.1f %8.1f %8.1f' % \
+            (result['case'], result['path'], result['events'],
+                 result['bytes'] / MB, result['elapsed_seconds'],
+                 result['events_per_second'], result['mb_per_second'],
+                 result['peak_rss_bytes'] / MB)
+        if not result['ok']: line += ' FAILED'
+        print(line)
+        sys.stdout.flush()
+
+    def compare(self, filename, tolerance):
+        """Compare rates with those of an earlier run; return number of
+        regressions."""
+        old = {}
+        for r in json.load(open(filename))['results']:
+            old[(r['case'], r['path'])] = r
+        print('\n%-8s %-10s %10s %10s %8s %8s' % \
+                  ('case', 'path', 'events/s', 'before', 'ratio', 'RSS'))
+        nbad = 0
+        for r in self.results:
+            key = (r['case'], r['path'])
+            if key not in old: continue
+            o = old[key]
+            ratio = r['events_per_second'] / o['events_per_second']
+            rss = float(r['peak_rss_bytes']) / max(o['peak_rss_bytes'], 1)
+            flag = ''
+            if ratio < 1 - tolerance or rss > 1 + tolerance or not r['ok']:
+                flag = ' REGRESSION'
+                nbad += 1
+            print('%-8s %-10s %10.1f %10.1f %8.3f %8.3f%s' % \
+                      (r['case'], r['path'], r['events_per_second'],
+                           o['events_per_second'], ratio, rss, flag))
+        return nbad
+
+    def save(self, filename):
+        record = {'date': time.strftime('%Y-%m-%d %H:%M:%S'),
+                  'host': os.uname()[1],
+                  'results': self.results}
+        open(filename, 'w').write(json.dumps(record, indent=2) + '\n')
+        print('\n=> results written to %s' % filename)
+# -----------------------------------------------------------------------
+USAGE = '''
+    Usage:
+        hepmcbench.py [options]
+
+    Options:
+        -d, --dir D         directory of the synthetic files and of the
+                            outputs (default bench)
+        -c, --case C        run case C, one of %s, or
+                            name,events,particles,fanout[,records], e.g.,
+                            huge,100,100000,5,CF (default: all cases)
+        -p, --path P        run path P: converter, filter or pandas
+                            (default: all)
+        -t, --threads N     run with N threads (default 1)
+            --chunk N       events per chunk of the pandas path
+                            (default 1000)
+        -o, --output F      write the results in JSON to F
+        -b, --baseline F    compare with the results F of an earlier run
+                            and exit with status 1 if the events/s drops,
+                            or the memory grows, by more than the tolerance
+            --tolerance X   relative tolerance (default 0.1)
+
+    The synthetic files are kept in the directory and are used again by
+    later runs with the same cases.
+        ''' % ', '.join([c[0] for c in CASES])
+
+def main():
+    argv = sys.argv[1:]
+    workdir  = 'bench'
+    cases    = []
+    paths    = []
+    nthreads = 1
+    chunk    = 1000
+    output   = ''
+    baseline = ''
+    tolerance= 0.1
+    known = dict([(c[0], c) for c in CASES])
+    while len(argv) > 0:
+        arg = argv.pop(0)
+        if len(argv) == 0:
+            sys.exit(USAGE)
+        if arg in ['-d', '--dir']:
+            workdir = argv.pop(0)
+        elif arg in ['-c', '--case']:
+            case = argv.pop(0)
+            if case in known:
+                cases.append(known[case])
+                continue
+            fields = case.split(',')
+            if len(fields) not in [4, 5]:
+                sys.exit('** hepmcbench: unknown case %s\n%s' % (case, USAGE))
+            fields.append('')
+            cases.append((fields[0], int(float(fields[1])), fields[2],
+                              int(fields[3]), fields[4]))
+        elif arg in ['-p', '--path']:
+            path = argv.pop(0)
+            if path not in PATHS:
+                sys.exit('** hepmcbench: unknown path %s\n%s' % (path, USAGE))
+            paths.append(path)
+        elif arg in ['-t', '--threads']:
+            nthreads = int(argv.pop(0))
+        elif arg == '--chunk':
+            chunk = int(argv.pop(0))
+        elif arg in ['-o', '--output']:
+            output = argv.pop(0)
+        elif arg in ['-b', '--baseline']:
+            baseline = argv.pop(0)
+        elif arg == '--tolerance':
+            tolerance = float(argv.pop(0))
+        else:
+            sys.exit(USAGE)
+    if cases == []: cases = CASES
+    if paths == []: paths = PATHS
+
+    bench = benchmark(workdir, nthreads, chunk)
+    if not os.path.exists(os.path.join(bench.converter, 'hepmcgen')):
+        sys.exit('** hepmcbench: build the converter first (make)')
+
+    print('\n%-8s %-10s %8s %8s %8s %10s %8s %8s' % \
+              ('case', 'path', 'events', 'MB', 'seconds', 'events/s',
+                   'MB/s', 'RSS MB'))
+    for case in cases:
+        for path in paths:
+            bench(case, path)
+
+    if output != '':
+        bench.save(output)
+
+    if baseline != '':
+        nbad = bench.compare(baseline, tolerance)
+        if nbad > 0:
+            sys.exit('\n** hepmcbench: %d regression(s)' % nbad)
+# -----------------------------------------------------------------------
+try:
+    main()
+except KeyboardInterrupt:
+    print('\nciao!')
@@ -0,0 +1,324 @@
+//---------------------------------------------------------------------------
+// File:        hepmc2root.cc
+// Description: write events in HepMC2 format to a flat ROOT ntuple using
+//              variable length arrays. This is the compiled version of
+//              bin/hepmc2root.py and writes the same Events tree.
+// Created:     16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "hepmcinput.h"
+#include "hepmcindex.h"
+#include "hepmcconverter.h"
+#include "hepmcmap.h"
+#include "hepmcmonitor.h"
+#include "hepmcoutput.h"
+#include "particleselection.h"
+using namespace std;
+//----------------------------------------------------------------------------
+const char* USAGE =
+  "\n"
+  "    Usage:\n"
+  "        hepmc2root [options] <HepMC-file> [output root file = <name>.root]\n"
+  "\n"
+  "    Options:\n"
+  "        -t, --threads N     parse and compress on N threads (default 1)\n"
+  "        -c, --compression N ROOT compression setting, e.g., 404 for lz4\n"
+  "                            level 4 (default: that of ROOT)\n"
+  "        -f, --first N       start at event N (ordinal position, from 0)\n"
+  "        -n, --count N       convert N events\n"
+  "        -s, --sample N      convert a random sample of N events\n"
+  "            --seed N        seed for random sample (default 42)\n"
+  "            --flush N       flush to the output file every N events\n"
+  "            --checkpoint N  every N events, save the events converted so\n"
+  "                            far, and how far the input has been read, in\n"
+  "                            the output file (tree only)\n"
+  "            --resume        continue the conversion from the last\n"
+  "                            checkpoint in the output file; give the same\n"
+  "                            input and options as before\n"
+  "            --format F      write a TTree (tree, the default) or an\n"
+  "                            RNTuple (rntuple) named Events, or Arrow\n"
+  "                            IPC files (arrow) <name>.arrow and\n"
+  "                            <name>.particles.arrow\n"
+  "            --schema S      layout of the particle branches of a TTree:\n"
+  "                            full (default), compact (Float_t) or\n"
+  "                            compact16 (Float16_t), optionally with\n"
+  "                            pidcode and/or vertex, e.g.,\n"
+  "                            compact16,pidcode,vertex; with kinematics,\n"
+  "                            for any format, add Particle_pt, _eta, _phi\n"
+  "                            and _rapidity\n"
+  "            --report F      write timers and counters of the stages of\n"
+  "                            the conversion to the JSON file F, every 10 s\n"
+  "                            and at the end\n"
+  "        -m, --max-particles N\n"
+  "                            store at most N particles per event, keeping\n"
+  "                            final-state and hard-process particles first\n"
+  "            --select S      store only the particles that pass the\n"
+  "                            selection S, e.g.,\n"
+  "                            \"status=21-29 or status=1 pt>0.5\"\n"
+  "                            (criteria: status=, pid=, |pid|=, pt>)\n"
+  "\n"
+  "    The event options use the index <HepMC-file>.idx, which is built\n"
+  "    on first use. Files compressed with gzip, xz or zstd are read\n"
+  "    directly.\n"
+  "\n"
+  "    Use \"-\" as HepMC-file to read from standard input; the output\n"
+  "    file is then stdin.root unless given. A named pipe can be given\n"
+  "    like a file. Events are converted as they arrive.\n"
+  "\n";
+
+string nameonly(string filename)
+{
+  int i = filename.rfind("/");
+  int j = filename.rfind(".");
+  if ( j < 0 || j < i ) j = filename.size();
+  return filename.substr(i+1, j-i-1);
+}
+
+/** The resume point of a checkpoint: the byte offset of the next event in
+    the input, the number of the last event converted and the number of
+    entries written.
+*/
+string resumePoint(size_t offset, int event, long long entries)
+{
+  ostringstream out;
+  out << "offset " << offset << " event " << event << " entries " << entries;
+  return out.str();
+}
+
+/// Return the stage times of converter and output.
+stageTimes stages(hepmcConverter& convert, hepmcOutput& output, double fill)
+{
+  stageTimes t = convert.times();
+  t.fill  = fill;
+  t.write = output.writeTime();
+  return t;
+}
+
+/// Decode a resume point. Return false if it is faulty.
+bool decodePoint(string point, size_t& offset, int& event, long long& entries)
+{
+  istringstream inp(point);
+  string key1, key2, key3;
+  inp >> key1 >> offset >> key2 >> event >> key3 >> entries;
+  return inp && key1 == "offset" && key2 == "event" && key3 == "entries";
+}
+
+int main(int argc, char** argv)
+{
+  int nthreads = 1;
+  long long first  = 0;
+  long long count  =-1;
+  long long sample = 0;
+  unsigned int seed= 42;
+  long long flush  = 0;
+  long long checkpoint = 0;
+  bool resume      = false;
+  int compression  =-1;
+  int maxparticles = 0;
+  string format("tree");
+  string schema("full");
+  string selection("");
+  string report("");
+
+  vector<string> args;
+  for(int i=1; i < argc; i++)
+    {
+      string arg(argv[i]);
+      if ( arg.size() < 2 || arg[0] != '-' )
+        {
+          args.push_back(arg);
+          continue;
+        }
+      if ( arg == "--resume" )
+        {
+          resume = true;
+          continue;
+        }
+      if ( i + 1 >= argc )
+        {
+          cout << USAGE;
+          exit(1);
+        }
+      if ( arg == "-t" || arg == "--threads" )
+        nthreads = atoi(argv[++i]);
+      else if ( arg == "-f" || arg == "--first" )
+        first = (long long)atof(argv[++i]);
+      else if ( arg == "-n" || arg == "--count" )
+        count = (long long)atof(argv[++i]);
+      else if ( arg == "-s" || arg == "--sample" )
+        sample = (long long)atof(argv[++i]);
+      else if ( arg == "--seed" )
+        seed = (unsigned int)atol(argv[++i]);
+      else if ( arg == "-c" || arg == "--compression" )
+        compression = atoi(argv[++i]);
+      else if ( arg == "--flush" )
+        flush = (long long)atof(argv[++i]);
+      else if ( arg == "--checkpoint" )
+        checkpoint = (long long)atof(argv[++i]);
+      else if ( arg == "--format" )
+        format = string(argv[++i]);
+      else if ( arg == "--schema" )
+        schema = string(argv[++i]);
+      else if ( arg == "-m" || arg == "--max-particles" )
+        maxparticles = atoi(argv[++i]);
+      else if ( arg == "--select" )
+        selection = string(argv[++i]);
+      else if ( arg == "--report" )
+        report = string(argv[++i]);
+      else
+        {
+          cout << "** hepmc2root: unknown option " << arg << endl << USAGE;
+          exit(1);
+        }
+    }
+  if ( args.size() < 1 )
+    {
+      cout << USAGE;
+      exit(0);
+    }
+  if ( (checkpoint > 0 || resume) && (first > 0 || count >= 0 || sample > 0) )
+    {
+      cout << "** hepmc2root: --checkpoint and --resume can't be used with "
+           << "--first, --count or --sample" << endl;
+      exit(1);
+    }
+  if ( (checkpoint > 0 || resume) && format != "tree" )
+    {
+      cout << "** hepmc2root: --checkpoint and --resume need --format tree"
+           << endl;
+      exit(1);
+    }
+  // a flush saves the tree header without the resume point, which would
+  // then no longer match the entries saved
+  if ( (checkpoint > 0 || resume) && flush > 0 )
+    {
+      cout << "** hepmc2root: use either --checkpoint or --resume, or --flush"
+           << endl;
+      exit(1);
+    }
+
+  string filename(args[0]);
+  string extension(format == "arrow" ? ".arrow" : ".root");
+  string outfilename;
+  if ( args.size() > 1 )
+    outfilename = args[1];
+  else if ( filename == "-" )
+    outfilename = string("stdin") + extension;
+  else
+    {
+      // skip extension of compressed file
+      string name = filename;
+      const char* ext[] = {".gz", ".xz", ".zst", 0};
+      for(int i=0; ext[i]; i++)
+        {
+          string e(ext[i]);
+          if ( name.size() > e.size() &&
+               name.substr(name.size()-e.size()) == e )
+            name = name.substr(0, name.size()-e.size());
+        }
+      outfilename = nameonly(name) + extension;
+    }
+
+  hepmcInput* stream = openHepMC(filename, nthreads);
+  if ( ! stream->good() ) exit(1);
+  cout << "HepMC version: " << stream->version() << endl;
+
+  // use index to go straight to the requested events
+  hepmcMap*   map   = 0;
+  hepmcIndex* index = 0;
+  hepmcInput* input = stream;
+  if ( first > 0 || count >= 0 || sample > 0 )
+    {
+      map = dynamic_cast<hepmcMap*>(stream);
+      if ( map == 0 )
+        {
+          cout << "** hepmc2root: event selection needs a regular file" << endl;
+          exit(1);
+        }
+      index = openIndex(*map, filename);
+      vector<size_t> events = selectEvents(index->size(),
+                                           first, count, sample, seed);
+      input = new hepmcIndexedInput(*map, *index, events);
+    }
+
+  Bag bag;
+  // the selection must outlive the converter
+  unique_ptr<particleSelection> select;
+  if ( selection != "" )
+    {
+      select.reset(new particleSelection(selection));
+      if ( ! select->good() ) exit(1);
+    }
+
+  hepmcOutput* output = openOutput(outfilename, bag, stream->version(),
+                                  format, schema, resume);
+  if ( output == 0 || ! output->good() ) exit(1);
+  output->setThreads(nthreads);
+  if ( compression >= 0 ) output->setCompression(compression);
+  output->setFlush(flush);
+  output->ls();
+
+  // skip the events converted before the last checkpoint; the input is
+  // only scanned for event boundaries up to that point
+  if ( resume )
+    {
+      size_t offset = 0;
+      int event = 0;
+      long long entries = 0;
+      string point = output->resumePoint();
+      if ( ! decodePoint(point, offset, event, entries) ||
+           entries != output->entries() || ! input->seek(offset) )
+        {
+          cout << "** hepmc2root: can't resume from checkpoint ("
+               << point << ") of " << outfilename << endl;
+          exit(1);
+        }
+      cout << "resume after event " << event << " (entry " << entries
+           << ") at byte " << offset << endl;
+    }
+
+  hepmcConverter convert(*input, bag, nthreads);
+  convert.setLimit(maxparticles);
+  convert.setSelection(select.get());
+  convert.setKinematics(("," + schema + ",").find(",kinematics,")
+                        != string::npos);
+
+  hepmcMonitor monitor(filename, outfilename, nthreads, report);
+  long long bytes = 0;
+  double fill = 0;
+  long long ii = output->entries();
+  while ( convert.next() )
+    {
+      // the time the output spends writing is not part of fill
+      double t = seconds() - output->writeTime();
+      output->fill();
+      fill += seconds() - output->writeTime() - t;
+
+      const char* begin = 0;
+      const char* end   = 0;
+      convert.range(begin, end);
+      bytes += end - begin;
+      monitor.count(bag.Event_numberP);
+      if ( monitor.events() % 1000 == 0 )
+        monitor.update(stages(convert, *output, fill), bytes, output->bytes());
+
+      ii++;
+      if ( checkpoint > 0 && ii % checkpoint == 0 )
+        output->checkpoint(resumePoint(convert.position(), bag.Event_number,
+                                       output->entries()));
+    }
+  output->close();
+  bool ok = convert.good() && output->good();
+  monitor.finish(stages(convert, *output, fill), bytes, output->bytes(), ok);
+  delete output;
+  if ( input != stream ) delete input;
+  if ( index ) delete index;
+  delete stream;
+  return ok ? 0 : 1;
+}
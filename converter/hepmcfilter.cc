@@ -0,0 +1,186 @@
+//---------------------------------------------------------------------------
+// File:        hepmcfilter.cc
+// Description: copy the events of a HepMC file that match a decay pattern
+//              to another HepMC file. This is the compiled version of
+//              bin/hepmcfilter.py: the events are parsed, and the pattern
+//              matched, on several threads, and the records of the
+//              selected events are copied unchanged: from a plain file
+//              they are copied by the kernel from file to file, otherwise
+//              they are written straight from the input buffer.
+// Created:     16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "decaypattern.h"
+#include "hepmcconverter.h"
+#include "hepmcindex.h"
+#include "hepmcinput.h"
+#include "hepmcmap.h"
+#include "rangewriter.h"
+using namespace std;
+//----------------------------------------------------------------------------
+const char* USAGE =
+  "\n"
+  "    Usage:\n"
+  "        hepmcfilter [options] <HepMC-file> parent d1 .. [, ...]\n"
+  "\n"
+  "    Options:\n"
+  "        -t, --threads N     parse and match on N threads (default 1)\n"
+  "        -o, --output F      output file (default filtered_<name>.hepmc)\n"
+  "        -f, --first N       start at event N (ordinal position, from 0)\n"
+  "        -n, --count N       filter N events\n"
+  "        -s, --sample N      filter a random sample of N events\n"
+  "            --seed N        seed for random sample (default 42)\n"
+  "\n"
+  "    The event options use the index <HepMC-file>.idx, which is built\n"
+  "    on first use; they need a regular, uncompressed file.\n"
+  "\n"
+  "    Example:\n"
+  "        hepmcfilter pMSSM_H0.hepmc 35 15 -15, 35 6 -6\n"
+  "\n"
+  "        This will select events in which the heavy neutral Higgs boson\n"
+  "        decays either to tau-/tau+ or to top/~top. A daughter may be a\n"
+  "        decay in parentheses, |pid| matches a particle and its\n"
+  "        antiparticle, and cc after a decay also matches its charge\n"
+  "        conjugate, e.g.,\n"
+  "\n"
+  "        hepmcfilter ttbar.hepmc \"6 (24 -11 12) 5 cc\"\n"
+  "\n";
+
+string nameonly(string filename)
+{
+  int i = filename.rfind("/");
+  int j = filename.rfind(".");
+  if ( j < 0 || j < i ) j = filename.size();
+  return filename.substr(i+1, j-i-1);
+}
+
+int main(int argc, char** argv)
+{
+  int nthreads = 1;
+  long long first  = 0;
+  long long count  =-1;
+  long long sample = 0;
+  unsigned int seed= 42;
+  string outfilename("");
+
+  // options precede the file name; the PDG ids that follow may be negative
+  int i = 1;
+  for(; i < argc; i++)
+    {
+      string arg(argv[i]);
+      if ( arg.size() < 2 || arg[0] != '-' ) break;
+      if ( i + 1 >= argc )
+        {
+          cout << USAGE;
+          exit(1);
+        }
+      if ( arg == "-t" || arg == "--threads" )
+        nthreads = atoi(argv[++i]);
+      else if ( arg == "-o" || arg == "--output" )
+        outfilename = string(argv[++i]);
+      else if ( arg == "-f" || arg == "--first" )
+        first = (long long)atof(argv[++i]);
+      else if ( arg == "-n" || arg == "--count" )
+        count = (long long)atof(argv[++i]);
+      else if ( arg == "-s" || arg == "--sample" )
+        sample = (long long)atof(argv[++i]);
+      else if ( arg == "--seed" )
+        seed = (unsigned int)atol(argv[++i]);
+      else
+        {
+          cout << "** hepmcfilter: unknown option " << arg << endl << USAGE;
+          exit(1);
+        }
+    }
+  if ( argc - i < 2 )
+    {
+      cout << USAGE;
+      exit(0);
+    }
+
+  string filename(argv[i++]);
+  string pattern("");
+  for(; i < argc; i++) pattern += string(" ") + string(argv[i]);
+
+  decayPattern match(pattern);
+  if ( ! match.good() ) exit(1);
+  cout << "decays: " << match.str() << endl;
+
+  hepmcInput* stream = openHepMC(filename, nthreads);
+  if ( ! stream->good() ) exit(1);
+
+  // use index to go straight to the requested events
+  hepmcMap*   map   = dynamic_cast<hepmcMap*>(stream);
+  hepmcIndex* index = 0;
+  hepmcInput* input = stream;
+  if ( first > 0 || count >= 0 || sample > 0 )
+    {
+      if ( map == 0 )
+        {
+          cout << "** hepmcfilter: event selection needs a regular file"
+               << endl;
+          exit(1);
+        }
+      index = openIndex(*map, filename);
+      vector<size_t> events = selectEvents(index->size(),
+                                           first, count, sample, seed);
+      input = new hepmcIndexedInput(*map, *index, events);
+    }
+
+  if ( outfilename == "" )
+    outfilename = string("filtered_") + nameonly(filename) + string(".hepmc");
+  rangeWriter out(outfilename);
+  if ( ! out.good() ) exit(1);
+
+  // the records of a memory mapped file remain valid, so they are queued
+  // and copied from the file; those of a stream, or of events that the
+  // index delivers apart from their neighbours, must be written before
+  // the next event is read
+  bool queue = map != 0 && input == stream;
+  int source = map ? open(filename.c_str(), O_RDONLY) : -1;
+  if ( source >= 0 ) out.setSource(source, map->data(), map->size());
+  out.write(input->header());
+
+  Bag bag;
+  hepmcConverter convert(*input, bag, nthreads);
+  convert.setPattern(&match);
+
+  while ( convert.next() )
+    {
+      const char* begin = 0;
+      const char* end   = 0;
+      convert.range(begin, end);
+      out.write(begin, end);
+      if ( ! queue ) out.flush();
+      if ( convert.events() % 100 == 0 )
+        printf("%10lld %10lld\n", convert.scanned(), convert.events());
+    }
+
+  // the trailer comes from the input, if it has one
+  string trailer = input->trailer();
+  if ( trailer == "" )
+    trailer = input->format() == 3 ?
+      "HepMC::Asciiv3-END_EVENT_LISTING\n" :
+      "HepMC::IO_GenEvent-END_EVENT_LISTING\n";
+  out.write(trailer);
+  out.close();
+  if ( source >= 0 ) close(source);
+  bool ok = convert.good() && out.good();
+
+  long long in = convert.scanned();
+  printf("\nSummary\n"
+         "    events(in):    %10lld\n"
+         "    events(out):   %10lld\n"
+         "    fraction:      %10.3e\n\n",
+         in, convert.events(), in > 0 ? (double)convert.events() / in : 0.0);
+  if ( input != stream ) delete input;
+  if ( index ) delete index;
+  delete stream;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,395 @@
+//---------------------------------------------------------------------------
+// File:        hepmcgen.cc
+// Description: write synthetic events in HepMC2 format for benchmarks. The
+//              events have the structure of a generator record: two beams,
+//              a hard process with a Z boson decaying to e+e- or mu+mu-,
+//              and a cascade of decays, with a chosen number of particles
+//              per event and of outgoing particles per vertex. The output
+//              is reproducible for a given seed.
+// Created:     16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+//----------------------------------------------------------------------------
+const char* USAGE =
+  "\n"
+  "    Usage:\n"
+  "        hepmcgen [options] [output HepMC-file = stdout]\n"
+  "\n"
+  "    Options:\n"
+  "        -n, --events N      number of events (default 1000)\n"
+  "        -p, --particles N   particles per event (default 1000), or\n"
+  "                            MIN:MAX for a number drawn uniformly in\n"
+  "                            log between MIN and MAX, e.g., 10:100000\n"
+  "        -f, --fanout N      at most N outgoing particles per decay\n"
+  "                            vertex (default 3)\n"
+  "        -r, --records L     optional records to write: C (cross\n"
+  "                            section), F (PDF information) or CF\n"
+  "        -s, --seed N        seed of the random numbers (default 42)\n"
+  "\n"
+  "    Use \"-\", or no file, to write to standard output, e.g.,\n"
+  "        hepmcgen -n 100000 -p 10:1000 -r CF | zstd > events.hepmc.zst\n"
+  "\n";
+
+namespace {
+  struct species
+  {
+    int pid;
+    double mass;
+  };
+
+  // decay products of the cascade
+  const species PRODUCTS[] =
+    {
+      {21, 0}, {1, 0.33}, {-1, 0.33}, {2, 0.33}, {-2, 0.33},
+      {211, 0.13957}, {-211, 0.13957}, {111, 0.13498}, {22, 0},
+      {321, 0.49368}, {-321, 0.49368}, {130, 0.49761}, {310, 0.49761},
+      {2212, 0.93827}, {-2212, 0.93827}, {2112, 0.93957}
+    };
+  const int NPRODUCTS = sizeof(PRODUCTS) / sizeof(PRODUCTS[0]);
+
+  const double EBEAM = 6500;
+  const double MPROTON = 0.93827;
+  const double MZ = 91.1876;
+
+  struct particle
+  {
+    int pid;
+    int status;
+    int vertex; // index of end vertex, or -1
+    int flow;   // colour flow code, or 0
+    double px, py, pz, e, m;
+  };
+
+  struct vertex
+  {
+    int orphans;  // incoming particles listed with the vertex (beams)
+    int first;    // index of the first particle listed with the vertex
+    int count;    // number of particles listed with the vertex
+    double x, y, z, ctau;
+  };
+}
+
+class eventWriter
+{
+ public:
+  eventWriter(FILE* out, int fanout, string records, unsigned long seed)
+    : out_(out),
+      fanout_(fanout),
+      xsection_(records.find_first_of("Cc") != string::npos),
+      pdf_(records.find_first_of("Ff") != string::npos),
+      random_(seed),
+      particles_(vector<particle>()),
+      vertices_(vector<vertex>()),
+      buffer_(vector<char>(1 << 20))
+  {}
+
+  ~eventWriter() {}
+
+  /// Generate event with about nparticles particles and write it.
+  void write(int number, int nparticles)
+  {
+    generate(nparticles);
+
+    line("E %d 1 %.16e %.16e %.16e 9999 -3 %d 1 3 0 1 %.16e\n",
+         number, MZ, 0.118, 1.0/128, (int)vertices_.size(), 1.0);
+    write("N 1 \"0\"\nU GEV MM\n");
+    if ( xsection_ )
+      line("C %.16e %.16e\n", 1.2e3 * (1 + 0.01 * gauss()), 12.0);
+    if ( pdf_ )
+      line("F 2 -2 %.16e %.16e %.16e %.16e %.16e 0 0\n",
+           x1_, x2_, MZ, 0.4 + 0.1 * uniform(), 0.3 + 0.1 * uniform());
+
+    // the barcodes of the particles are their positions + 1, those of the
+    // vertices minus their positions + 1
+    for(size_t v=0; v < vertices_.size(); v++)
+      {
+        const vertex& vx = vertices_[v];
+        line("V %d 0 %.16e %.16e %.16e %.16e %d %d 0\n",
+             -(int)(v+1), vx.x, vx.y, vx.z, vx.ctau,
+             vx.orphans, vx.count - vx.orphans);
+        for(int i=vx.first; i < vx.first + vx.count; i++)
+          {
+            const particle& p = particles_[i];
+            double pt = sqrt(p.px * p.px + p.py * p.py);
+            int endv = p.vertex < 0 ? 0 : -(p.vertex+1);
+            if ( p.flow > 0 )
+              line("P %d %d %.16e %.16e %.16e %.16e %.16e %d "
+                   "%.16e %.16e %d 1 1 %d\n",
+                   i+1, p.pid, p.px, p.py, p.pz, p.e, p.m, p.status,
+                   atan2(pt, p.pz), atan2(p.py, p.px), endv, p.flow);
+            else
+              line("P %d %d %.16e %.16e %.16e %.16e %.16e %d "
+                   "%.16e %.16e %d 0\n",
+                   i+1, p.pid, p.px, p.py, p.pz, p.e, p.m, p.status,
+                   atan2(pt, p.pz), atan2(p.py, p.px), endv);
+          }
+      }
+  }
+
+  /// Write string as is.
+  void write(string s) { fputs(s.c_str(), out_); }
+
+ private:
+  FILE* out_;
+  int fanout_;
+  bool xsection_;
+  bool pdf_;
+  mt19937_64 random_;
+  vector<particle> particles_;
+  vector<vertex> vertices_;
+  vector<char> buffer_;
+  double x1_, x2_;
+  int flow_;
+
+  double uniform() { return uniform_real_distribution<double>()(random_); }
+  double gauss()   { return normal_distribution<double>()(random_); }
+  int integer(int n) { return uniform_int_distribution<int>(0, n-1)(random_); }
+
+  template <typename... Args>
+  void line(const char* format, Args... args)
+  {
+    int n = snprintf(&buffer_[0], buffer_.size(), format, args...);
+    fwrite(&buffer_[0], 1, n, out_);
+  }
+
+  /// Add particle, produced at the last vertex.
+  void add(int pid, int status, double px, double py, double pz, double m)
+  {
+    particle p;
+    p.pid = pid;
+    p.status = status;
+    p.vertex = -1;
+    int apid = abs(pid);
+    p.flow = apid < 7 || apid == 21 ? 500 + ++flow_ : 0;
+    p.px = px;
+    p.py = py;
+    p.pz = pz;
+    p.e  = sqrt(px * px + py * py + pz * pz + m * m);
+    p.m  = m;
+    particles_.push_back(p);
+    vertices_.back().count++;
+  }
+
+  /// Add vertex at which particle parent, if any, ends.
+  void addVertex(int parent, double x, double y, double z, double ctau)
+  {
+    vertex v;
+    v.orphans = 0;
+    v.first = particles_.size();
+    v.count = 0;
+    v.x = x;
+    v.y = y;
+    v.z = z;
+    v.ctau = ctau;
+    if ( parent >= 0 ) particles_[parent].vertex = vertices_.size();
+    vertices_.push_back(v);
+  }
+
+  /// Generate the particles and vertices of an event.
+  void generate(int nparticles)
+  {
+    particles_.clear();
+    vertices_.clear();
+    flow_ = 0;
+    double z0 = 50 * gauss();
+
+    // the beams, listed as incoming particles of the vertices at which
+    // they radiate the partons of the hard process
+    x1_ = 0.01 + 0.1 * uniform();
+    x2_ = MZ * MZ / (4 * EBEAM * EBEAM * x1_);
+    if ( x2_ > 1 ) x2_ = 1;
+    for(int b=0; b < 2; b++)
+      {
+        double sign = b == 0 ? 1 : -1;
+        double x = b == 0 ? x1_ : x2_;
+        addVertex(-1, 0, 0, z0, 0);
+        vertices_.back().orphans = 1;
+        add(2212, 4, 0, 0, sign * EBEAM, MPROTON);
+        add(b == 0 ? 2 : -2, 21, 0, 0, sign * x * EBEAM, 0);
+        particles_.back().vertex = 2;
+        particles_[particles_.size()-2].vertex = b;
+      }
+
+    // the hard process: a Z boson and radiated partons
+    addVertex(-1, 0, 0, z0, 0);
+    double pz = (x1_ - x2_) * EBEAM;
+    double kx = 20 * gauss();
+    double ky = 20 * gauss();
+    add(23, 22, kx, ky, pz, MZ);
+    int nrad = 1 + integer(fanout_ > 1 ? fanout_ - 1 : 1);
+    if ( nrad > nparticles - 7 ) nrad = nparticles - 7;
+    for(int i=0; i < nrad; i++)
+      add(21, 23, -kx / nrad + 10 * gauss(), -ky / nrad + 10 * gauss(),
+          300 * gauss(), 0);
+
+    // Z -> l+l-
+    int z = vertices_[2].first;
+    int lepton = uniform() < 0.5 ? 11 : 13;
+    addVertex(z, 0, 0, z0, 0);
+    decay(z, -lepton, lepton, 1);
+
+    // cascade: the partons of the hard process, then their decay products
+    // decay in the order in which they are made, each into 1 to fanout
+    // particles, until the event is full
+    int leptons = z + nrad + 1;
+    for(int parent=z+1; (int)particles_.size() < nparticles; parent++)
+      {
+        if ( parent == leptons ) parent += 2;
+        const particle& p = particles_[parent];
+        const vertex& pv = vertices_[vertexOf(parent)];
+        double d = 1.0e-3 * uniform();
+        double ctau = pv.ctau + d;
+        addVertex(parent,
+                  pv.x + d * p.px / p.e, pv.y + d * p.py / p.e,
+                  pv.z + d * p.pz / p.e, ctau);
+        int left = nparticles - particles_.size();
+        int n = 1 + integer(fanout_);
+        if ( n > left ) n = left;
+        for(int i=0; i < n; i++)
+          {
+            const species& s = PRODUCTS[integer(NPRODUCTS)];
+            const particle& q = particles_[parent];
+            add(s.pid, 1,
+                q.px / n + 0.3 * gauss(), q.py / n + 0.3 * gauss(),
+                q.pz / n + 1.0 * gauss(), s.mass);
+          }
+        if ( particles_[parent].status == 1 ) particles_[parent].status = 2;
+      }
+  }
+
+  /// Decay particle into the two particles pid1 and pid2 of mass m.
+  void decay(int parent, int pid1, int pid2, int status)
+  {
+    const particle& p = particles_[parent];
+    double m = pid2 == 11 ? 0.000511 : 0.10566;
+    double ct = 2 * uniform() - 1;
+    double st = sqrt(1 - ct * ct);
+    double phi = 2 * M_PI * uniform();
+    double q = p.m / 2;
+    double px = p.px, py = p.py, pz = p.pz, e = p.e;
+    // boost the decay products along the momentum of the parent
+    double bx = px / e, by = py / e, bz = pz / e;
+    double b2 = bx * bx + by * by + bz * bz;
+    double g  = 1 / sqrt(1 - b2);
+    for(int k=0; k < 2; k++)
+      {
+        double sign = k == 0 ? 1 : -1;
+        double qx = sign * q * st * cos(phi);
+        double qy = sign * q * st * sin(phi);
+        double qz = sign * q * ct;
+        double bq = bx * qx + by * qy + bz * qz;
+        double c  = b2 > 0 ? (g - 1) * bq / b2 + g * q : 0;
+        add(k == 0 ? pid1 : pid2, status,
+            qx + c * bx, qy + c * by, qz + c * bz, m);
+      }
+  }
+
+  /// Return index of production vertex of particle.
+  int vertexOf(int index)
+  {
+    // particles are listed with their production vertex, in order
+    int lo = 0, hi = vertices_.size() - 1;
+    while ( lo < hi )
+      {
+        int mid = (lo + hi + 1) / 2;
+        if ( vertices_[mid].first <= index )
+          lo = mid;
+        else
+          hi = mid - 1;
+      }
+    return lo;
+  }
+};
+
+int main(int argc, char** argv)
+{
+  long long nevents = 1000;
+  double pmin = 1000;
+  double pmax = 1000;
+  int fanout = 3;
+  string records("");
+  unsigned long seed = 42;
+
+  vector<string> args;
+  for(int i=1; i < argc; i++)
+    {
+      string arg(argv[i]);
+      if ( arg.size() < 2 || arg[0] != '-' )
+        {
+          args.push_back(arg);
+          continue;
+        }
+      if ( i + 1 >= argc )
+        {
+          cout << USAGE;
+          exit(1);
+        }
+      if ( arg == "-n" || arg == "--events" )
+        nevents = (long long)atof(argv[++i]);
+      else if ( arg == "-p" || arg == "--particles" )
+        {
+          string range(argv[++i]);
+          size_t colon = range.find(':');
+          pmin = atof(range.substr(0, colon).c_str());
+          pmax = colon == string::npos ?
+            pmin : atof(range.substr(colon+1).c_str());
+        }
+      else if ( arg == "-f" || arg == "--fanout" )
+        fanout = atoi(argv[++i]);
+      else if ( arg == "-r" || arg == "--records" )
+        records = string(argv[++i]);
+      else if ( arg == "-s" || arg == "--seed" )
+        seed = strtoul(argv[++i], 0, 10);
+      else
+        {
+          cout << "** hepmcgen: unknown option " << arg << endl << USAGE;
+          exit(1);
+        }
+    }
+  // the beams, the hard process and the Z decay take up to 8 particles
+  if ( pmin < 10 || pmax < pmin || fanout < 1 ||
+       records.find_first_not_of("CcFf") != string::npos )
+    {
+      cout << "** hepmcgen: need 10 <= MIN <= MAX particles, a fanout of at "
+           << "least 1 and records C and/or F" << endl << USAGE;
+      exit(1);
+    }
+
+  string filename = args.size() > 0 ? args[0] : string("-");
+  FILE* out = filename == "-" ? stdout : fopen(filename.c_str(), "w");
+  if ( out == 0 )
+    {
+      cerr << "** hepmcgen: can't open " << filename << endl;
+      exit(1);
+    }
+  static char buffer[1 << 20];
+  setvbuf(out, buffer, _IOFBF, sizeof(buffer));
+
+  eventWriter writer(out, fanout, records, seed);
+  mt19937_64 random(seed + 1);
+  uniform_real_distribution<double> uniform;
+  writer.write("\nHepMC::Version 2.06.09\n"
+               "HepMC::IO_GenEvent-START_EVENT_LISTING\n");
+  for(long long i=0; i < nevents; i++)
+    {
+      int n = (int)(pmin * pow(pmax / pmin, uniform(random)) + 0.5);
+      writer.write(i, n);
+    }
+  writer.write("HepMC::IO_GenEvent-END_EVENT_LISTING\n");
+
+  bool ok = fflush(out) == 0 && ! ferror(out);
+  if ( out != stdout && fclose(out) != 0 ) ok = false;
+  if ( ! ok )
+    {
+      cerr << "** hepmcgen: error writing " << filename << endl;
+      return 1;
+    }
+  return 0;
+}
@@ -0,0 +1,47 @@
+//---------------------------------------------------------------------------
+// File:        hepmcindex.cc
+// Description: build the byte-offset index <HepMC-file>.idx of the events
+//              in a HepMC file and, optionally, list it.
+// Created:     16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "hepmcmap.h"
+#include "hepmcindex.h"
+using namespace std;
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  if ( argc < 2 )
+    {
+      cout << endl
+           << "    Usage:" << endl
+           << "        hepmcindex <HepMC-file> [-l (list events)]" << endl
+           << endl;
+      exit(0);
+    }
+  string filename(argv[1]);
+  bool list = argc > 2 && string(argv[2]) == "-l";
+
+  hepmcMap input(filename);
+  if ( ! input.good() ) exit(1);
+
+  hepmcIndex* index = openIndex(input, filename);
+  if ( list )
+    {
+      printf("%10s %10s %16s %10s %10s\n",
+             "entry", "event", "offset", "vertices", "particles");
+      for(size_t i=0; i < index->size(); i++)
+        {
+          indexEntry& e = (*index)[i];
+          printf("%10lu %10d %16llu %10d %10d\n",
+                 (unsigned long)i, e.number, (unsigned long long)e.offset,
+                 e.numberV, e.numberP);
+        }
+    }
+  cout << "number of events: " << index->size() << endl;
+  delete index;
+  return 0;
+}
@@ -0,0 +1,246 @@
+//---------------------------------------------------------------------------
+// File:        hepmcsplit.cc
+// Description: split a HepMC file into shards, each a valid HepMC file
+//              with the header of the original, so that the shards can
+//              be converted by separate jobs. The file is cut at event
+//              boundaries, found by a scan for the "E" lines; the events
+//              are not parsed. The shards are written as in hepmcfilter.
+// Created:     16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hepmcinput.h"
+#include "hepmcmap.h"
+#include "rangewriter.h"
+using namespace std;
+//----------------------------------------------------------------------------
+const char* USAGE =
+  "\n"
+  "    Usage:\n"
+  "        hepmcsplit [options] <HepMC-file>\n"
+  "\n"
+  "    Options (one of -n, -e, -b is needed):\n"
+  "        -n, --shards N      split into N shards of about equal size\n"
+  "                            (needs a regular, uncompressed file)\n"
+  "        -e, --events N      put N events in each shard\n"
+  "        -b, --bytes N       put about N bytes in each shard, e.g., 2e9\n"
+  "        -o, --output P      shards are P_0000.hepmc, P_0001.hepmc,...\n"
+  "                            (default <name>)\n"
+  "\n";
+
+string nameonly(string filename)
+{
+  int i = filename.rfind("/");
+  int j = filename.rfind(".");
+  if ( j < 0 || j < i ) j = filename.size();
+  return filename.substr(i+1, j-i-1);
+}
+
+class shardWriter
+{
+ public:
+  shardWriter(hepmcInput& input, string prefix, int source)
+    : input_(&input),
+      map_(dynamic_cast<hepmcMap*>(&input)),
+      prefix_(prefix),
+      source_(source),
+      out_(0),
+      shards_(0),
+      events_(0),
+      good_(true)
+  {}
+
+  ~shardWriter() { close(""); }
+
+  bool good() { return good_; }
+
+  int shards() { return shards_; }
+
+  long long events() { return events_; }
+
+  /// Start next shard.
+  void open()
+  {
+    close("");
+    char name[32];
+    snprintf(name, sizeof(name), "_%04d.hepmc", shards_++);
+    out_ = new rangeWriter(prefix_ + string(name));
+    if ( ! out_->good() ) good_ = false;
+    if ( source_ >= 0 )
+      out_->setSource(source_, map_->data(), map_->size());
+    out_->write(input_->header());
+  }
+
+  /// Write the nevents events in [begin, end) to current shard.
+  void write(const char* begin, const char* end, long long nevents)
+  {
+    out_->write(begin, end);
+    events_ += nevents;
+  }
+
+  /// End current shard with the given trailer, or the usual one.
+  void close(string trailer)
+  {
+    if ( out_ == 0 ) return;
+    if ( trailer == "" )
+      trailer = input_->format() == 3 ?
+        "HepMC::Asciiv3-END_EVENT_LISTING\n" :
+        "HepMC::IO_GenEvent-END_EVENT_LISTING\n";
+    out_->write(trailer);
+    out_->close();
+    if ( ! out_->good() ) good_ = false;
+    delete out_;
+    out_ = 0;
+  }
+
+  /// Write queued ranges, which are about to become invalid.
+  void flush() { if ( out_ ) out_->flush(); }
+
+ private:
+  hepmcInput* input_;
+  hepmcMap* map_;
+  string prefix_;
+  int source_;
+  rangeWriter* out_;
+  int shards_;
+  long long events_;
+  bool good_;
+};
+
+int main(int argc, char** argv)
+{
+  long long nshards = 0;
+  long long nevents = 0;
+  long long nbytes  = 0;
+  string prefix("");
+
+  vector<string> args;
+  for(int i=1; i < argc; i++)
+    {
+      string arg(argv[i]);
+      if ( arg.size() < 2 || arg[0] != '-' )
+        {
+          args.push_back(arg);
+          continue;
+        }
+      if ( i + 1 >= argc )
+        {
+          cout << USAGE;
+          exit(1);
+        }
+      if ( arg == "-n" || arg == "--shards" )
+        nshards = (long long)atof(argv[++i]);
+      else if ( arg == "-e" || arg == "--events" )
+        nevents = (long long)atof(argv[++i]);
+      else if ( arg == "-b" || arg == "--bytes" )
+        nbytes = (long long)atof(argv[++i]);
+      else if ( arg == "-o" || arg == "--output" )
+        prefix = string(argv[++i]);
+      else
+        {
+          cout << "** hepmcsplit: unknown option " << arg << endl << USAGE;
+          exit(1);
+        }
+    }
+  if ( args.size() < 1 || (nshards <= 0 && nevents <= 0 && nbytes <= 0) )
+    {
+      cout << USAGE;
+      exit(0);
+    }
+
+  string filename(args[0]);
+  if ( prefix == "" ) prefix = nameonly(filename);
+
+  hepmcInput* input = openHepMC(filename);
+  if ( ! input->good() ) exit(1);
+  hepmcMap* map = dynamic_cast<hepmcMap*>(input);
+  if ( nshards > 0 )
+    {
+      if ( map == 0 )
+        {
+          cout << "** hepmcsplit: --shards needs a regular file; "
+               << "use --events or --bytes" << endl;
+          exit(1);
+        }
+      nbytes = (map->size() - map->first() + nshards - 1) / nshards;
+      if ( nbytes < 1 ) nbytes = 1;
+    }
+
+  // the ranges of a memory mapped file remain valid and are copied from
+  // the file
+  int source = map ? open(filename.c_str(), O_RDONLY) : -1;
+  shardWriter shard(*input, prefix, source);
+
+  // read blocks of complete events and cut them where a shard is full
+  const size_t BLOCK = 1 << 24;
+  vector<char> buffer;
+  const char* begin = 0;
+  const char* end   = 0;
+  long long count = 0; // events in current shard
+  long long bytes = 0; // bytes in current shard
+  while ( shard.good() && input->read(begin, end, BLOCK, buffer) )
+    {
+      const char* p = begin;
+      while ( p < end )
+        {
+          if ( count == 0 ) shard.open();
+
+          // find where the current shard is full, or the end of the block
+          const char* q = end;
+          long long n = 0;
+          if ( nevents > 0 )
+            {
+              q = p;
+              while ( q < end && count + n < nevents )
+                {
+                  const char* e = (const char*)memchr(q, '\n', end - q);
+                  q = e ? findEvent(e + 1, end) : end;
+                  n++;
+                }
+            }
+          else
+            {
+              if ( nbytes - bytes < end - p )
+                {
+                  const char* full = p + (nbytes - bytes);
+                  const char* e = (const char*)memchr(full, '\n', end - full);
+                  q = e ? findEvent(e + 1, end) : end;
+                }
+              const char* r = p;
+              while ( r < q )
+                {
+                  const char* e = (const char*)memchr(r, '\n', q - r);
+                  r = e ? findEvent(e + 1, q) : q;
+                  n++;
+                }
+            }
+          shard.write(p, q, n);
+          count += n;
+          bytes += q - p;
+          p = q;
+          if ( q < end || (nevents > 0 && count >= nevents) ||
+               (nevents <= 0 && bytes >= nbytes) )
+            {
+              // the trailer of the input is known once its last block has
+              // been read
+              shard.close(input->trailer());
+              count = bytes = 0;
+            }
+        }
+      shard.flush();
+    }
+  shard.close(input->trailer());
+  bool ok = input->good() && shard.good();
+  if ( source >= 0 ) close(source);
+
+  printf("%s: %lld events in %d shards %s_0000.hepmc ...\n",
+         filename.c_str(), shard.events(), shard.shards(), prefix.c_str());
+  delete input;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,460 @@
+//---------------------------------------------------------------------------
+// File:        hepmcstats.cc
+// Description: print the statistics of HepMC files that are needed to plan
+//              their conversion: the number of events, the distribution of
+//              the number of particles per event, the largest events and
+//              the cross sections. Only the event lines and the lines that
+//              precede the first vertex are decoded. The particles are
+//              counted from the counts on the vertex lines of HepMC2, found
+//              by a scan for the "V" keys, and read from the event lines of
+//              HepMC3; the particle lines are never looked at.
+// Created:     16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "hepmcinput.h"
+#include "hepmcmonitor.h"
+#include "hepmcparser.h"
+using namespace std;
+//----------------------------------------------------------------------------
+const char* USAGE =
+  "\n"
+  "    Usage:\n"
+  "        hepmcstats [options] <HepMC-file> [<HepMC-file>...]\n"
+  "\n"
+  "    Options:\n"
+  "        -t, --threads N     decompress zstd files on N threads\n"
+  "                            (default 1)\n"
+  "        -j, --json F        write the statistics of the files to the\n"
+  "                            JSON file F\n"
+  "\n";
+
+namespace {
+  /// Quote string for JSON.
+  string quote(const string& s)
+  {
+    string q("\"");
+    for(size_t i=0; i < s.size(); i++)
+      {
+        if ( s[i] == '"' || s[i] == '\\' ) q += '\\';
+        q += s[i];
+      }
+    return q + string("\"");
+  }
+
+  /// True if the word at p is the given word.
+  bool isWord(const char* p, const char* end, const char* word)
+  {
+    size_t n = strlen(word);
+    return (size_t)(end - p) > n && memcmp(p, word, n) == 0 &&
+      (p[n] == ' ' || p[n] == '\t' || p[n] == '\n');
+  }
+
+  const double MB = 1024 * 1024;
+}
+
+class hepmcStats
+{
+ public:
+  hepmcStats(string filename)
+    : filename_(filename),
+      version_(""),
+      format_(2),
+      ok_(true),
+      events_(0),
+      faulty_(0),
+      particles_(0),
+      vertices_(0),
+      bytes_(0),
+      sum2_(0),
+      first_(0),
+      last_(0),
+      maxP_(0),
+      maxPevent_(0),
+      maxBytes_(0),
+      maxBytesEvent_(0),
+      xsections_(0),
+      xfirst_(0),
+      xfirstError_(0),
+      xlast_(0),
+      xlastError_(0),
+      seconds_(0),
+      count_(vector<long long>())
+  {}
+
+  ~hepmcStats() {}
+
+  /// Scan the input.
+  void scan(hepmcInput& input)
+  {
+    double t = seconds();
+    version_ = input.version();
+    format_  = input.format();
+    const size_t BLOCK = 1 << 24;
+    vector<char> buffer;
+    const char* begin = 0;
+    const char* end   = 0;
+    while ( input.read(begin, end, BLOCK, buffer) )
+      {
+        const char* p = begin;
+        while ( p < end )
+          {
+            const char* q = (const char*)memchr(p, '\n', end - p);
+            q = q ? findEvent(q + 1, end) : end;
+            event(p, q);
+            p = q;
+          }
+      }
+    if ( ! input.good() ) ok_ = false;
+    seconds_ = seconds() - t;
+  }
+
+  /// Print statistics.
+  void print()
+  {
+    double n = events_ > 0 ? events_ : 1;
+    double mean = particles_ / n;
+    double rms  = sqrt(fabs(sum2_ / n - mean * mean));
+    printf("file:                 %s\n", filename_.c_str());
+    printf("format:               HepMC%d (%s)\n",
+           format_, version_.c_str());
+    printf("events:               %lld (numbers %lld to %lld)\n",
+           events_, first_, last_);
+    if ( faulty_ > 0 )
+      printf("faulty events:        %lld\n", faulty_);
+    printf("vertices:             %lld\n", vertices_);
+    printf("particles:            %lld\n", particles_);
+    printf("particles per event:  mean %.1f, rms %.1f, min %d, max %d "
+           "(event %lld)\n",
+           mean, rms, minimum(), maxP_, maxPevent_);
+    printf("                      median %d, 90%% %d, 99%% %d\n",
+           quantile(0.5), quantile(0.9), quantile(0.99));
+    printf("bytes per event:      mean %.0f, max %lld (event %lld)\n",
+           bytes_ / n, maxBytes_, maxBytesEvent_);
+    if ( xsections_ > 0 )
+      printf("cross section:        %lld records, last %.6e +- %.6e, "
+             "first %.6e +- %.6e\n",
+             xsections_, xlast_, xlastError_, xfirst_, xfirstError_);
+    else
+      printf("cross section:        none\n");
+    printf("scanned:              %.1f MB in %.2f s (%.1f MB/s)\n",
+           bytes_ / MB, seconds_, seconds_ > 0 ? bytes_ / MB / seconds_ : 0);
+
+    printf("particles per event   events\n");
+    vector<int> edges = bins();
+    vector<long long> h = histogram(edges);
+    for(size_t i=0; i < h.size(); i++)
+      if ( h[i] > 0 )
+        printf("%9d - %9d %10lld\n", edges[i], edges[i+1]-1, h[i]);
+    printf("\n");
+  }
+
+  /// Return statistics in JSON.
+  string json()
+  {
+    double n = events_ > 0 ? events_ : 1;
+    double mean = particles_ / n;
+    ostringstream out;
+    out.precision(10);
+    out << "  {\n"
+        << "    \"file\": "                 << quote(filename_) << ",\n"
+        << "    \"format\": "               << format_ << ",\n"
+        << "    \"version\": "              << quote(version_) << ",\n"
+        << "    \"ok\": "                   << (ok_ ? "true" : "false")
+        << ",\n"
+        << "    \"events\": "               << events_ << ",\n"
+        << "    \"faulty_events\": "        << faulty_ << ",\n"
+        << "    \"first_event\": "          << first_ << ",\n"
+        << "    \"last_event\": "           << last_ << ",\n"
+        << "    \"vertices\": "             << vertices_ << ",\n"
+        << "    \"particles\": "            << particles_ << ",\n"
+        << "    \"bytes\": "                << bytes_ << ",\n"
+        << "    \"particles_mean\": "       << mean << ",\n"
+        << "    \"particles_rms\": "
+        << sqrt(fabs(sum2_ / n - mean * mean)) << ",\n"
+        << "    \"particles_min\": "        << minimum() << ",\n"
+        << "    \"particles_max\": "        << maxP_ << ",\n"
+        << "    \"particles_max_event\": "  << maxPevent_ << ",\n"
+        << "    \"particles_median\": "     << quantile(0.5) << ",\n"
+        << "    \"particles_90\": "         << quantile(0.9) << ",\n"
+        << "    \"particles_99\": "         << quantile(0.99) << ",\n"
+        << "    \"bytes_max\": "            << maxBytes_ << ",\n"
+        << "    \"bytes_max_event\": "      << maxBytesEvent_ << ",\n"
+        << "    \"xsection_records\": "     << xsections_ << ",\n"
+        << "    \"xsection_first\": ["      << xfirst_ << ", "
+        << xfirstError_ << "],\n"
+        << "    \"xsection_last\": ["       << xlast_ << ", "
+        << xlastError_ << "],\n"
+        << "    \"seconds\": "              << seconds_ << ",\n"
+        << "    \"histogram\": [";
+    // bins of the number of particles per event: [low, high, events]
+    vector<int> edges = bins();
+    vector<long long> h = histogram(edges);
+    string delim("");
+    for(size_t i=0; i < h.size(); i++)
+      {
+        out << delim << "[" << edges[i] << ", " << edges[i+1]-1 << ", "
+            << h[i] << "]";
+        delim = ", ";
+      }
+    out << "]\n"
+        << "  }";
+    return out.str();
+  }
+
+  bool good() { return ok_; }
+
+ private:
+  string filename_;
+  string version_;
+  int format_;
+  bool ok_;
+  long long events_;
+  long long faulty_;
+  long long particles_;
+  long long vertices_;
+  long long bytes_;
+  double sum2_;
+  long long first_;
+  long long last_;
+  int maxP_;
+  long long maxPevent_;
+  long long maxBytes_;
+  long long maxBytesEvent_;
+  long long xsections_;
+  double xfirst_;
+  double xfirstError_;
+  double xlast_;
+  double xlastError_;
+  double seconds_;
+  vector<long long> count_; // number of events by number of particles
+
+  /// Decode the event in [p, end).
+  void event(const char* p, const char* end)
+  {
+    // HepMC2: E number n-mpi scale alphaQCD alphaQED process-id
+    //         signal-vertex n-vertices ...
+    // HepMC3: E number n-vertices n-particles
+    long long number = 0;
+    int nv = 0;
+    int np = 0;
+    const char* q = getField(p + 1, end, number);
+    if ( format_ == 2 )
+      for(int i=0; i < 6; i++) q = skipField(q, end);
+    q = getField(q, end, nv);
+    if ( format_ == 3 ) q = getField(q, end, np);
+    bool ok = q != 0;
+
+    // the cross section precedes the vertices and particles
+    const char* r = nextLine(p, end);
+    while ( r < end && *r != 'V' && *r != 'P' )
+      {
+        double value = 0, error = 0;
+        q = r + 1;
+        if ( *r == 'A' )
+          {
+            // HepMC3: A 0 GenCrossSection value error ...
+            int id = -1;
+            q = getField(q, end, id);
+            q = q ? skipSpace(q, end) : 0;
+            if ( q == 0 || id != 0 || ! isWord(q, end, "GenCrossSection") )
+              q = 0;
+            else
+              q = skipField(q, end);
+          }
+        else if ( *r != 'C' )
+          q = 0;
+        if ( q != 0 )
+          {
+            q = getField(q, end, value);
+            q = getField(q, end, error);
+            if ( q != 0 ) xsection(value, error);
+          }
+        r = nextLine(r, end);
+      }
+
+    // HepMC2: V barcode id x y z ctau n-orphans n-out ...; only the
+    // vertex lines are visited, since an upper case V appears only as
+    // their key
+    if ( format_ == 2 )
+      {
+        int n = 0;
+        for(; r < end && n < nv; r++)
+          {
+            r = (const char*)memchr(r, 'V', end - r);
+            if ( r == 0 ) break;
+            if ( r[-1] != '\n' ) continue;
+            int norphans = 0, nout = 0;
+            q = r + 1;
+            for(int i=0; i < 6; i++) q = skipField(q, end);
+            q = getField(q, end, norphans);
+            q = getField(q, end, nout);
+            if ( q == 0 ) break;
+            np += norphans + nout;
+            n++;
+          }
+        if ( n < nv ) ok = false;
+      }
+    if ( ! ok )
+      {
+        if ( faulty_++ == 0 )
+          cerr << "** hepmcstats: faulty event after event " << last_
+               << " in " << filename_ << endl;
+        ok_ = false;
+        return;
+      }
+
+    if ( events_ == 0 ) first_ = number;
+    last_ = number;
+    events_++;
+    vertices_  += nv;
+    particles_ += np;
+    sum2_      += (double)np * np;
+    long long bytes = end - p;
+    bytes_ += bytes;
+    if ( np > maxP_ )
+      {
+        maxP_ = np;
+        maxPevent_ = number;
+      }
+    if ( bytes > maxBytes_ )
+      {
+        maxBytes_ = bytes;
+        maxBytesEvent_ = number;
+      }
+    if ( np >= (int)count_.size() ) count_.resize(np + 1, 0);
+    count_[np]++;
+  }
+
+  void xsection(double value, double error)
+  {
+    if ( xsections_++ == 0 )
+      {
+        xfirst_ = value;
+        xfirstError_ = error;
+      }
+    xlast_ = value;
+    xlastError_ = error;
+  }
+
+  int minimum()
+  {
+    for(size_t n=0; n < count_.size(); n++)
+      if ( count_[n] > 0 ) return n;
+    return 0;
+  }
+
+  /// Return smallest number of particles of at least fraction f of events.
+  int quantile(double f)
+  {
+    long long k = (long long)ceil(f * events_);
+    long long sum = 0;
+    for(size_t n=0; n < count_.size(); n++)
+      {
+        sum += count_[n];
+        if ( sum >= k && sum > 0 ) return n;
+      }
+    return 0;
+  }
+
+  /// Return edges 0, 1, 2, 5, 10, 20, 50,... up to beyond the maximum.
+  vector<int> bins()
+  {
+    vector<int> edges(1, 0);
+    const int steps[] = {1, 2, 5};
+    for(long long decade=1; edges.back() <= maxP_; decade *= 10)
+      for(int i=0; i < 3 && edges.back() <= maxP_; i++)
+        edges.push_back(steps[i] * decade);
+    return edges;
+  }
+
+  vector<long long> histogram(const vector<int>& edges)
+  {
+    vector<long long> h(edges.size() - 1, 0);
+    size_t bin = 0;
+    for(size_t n=0; n < count_.size(); n++)
+      {
+        while ( (int)n >= edges[bin+1] ) bin++;
+        h[bin] += count_[n];
+      }
+    return h;
+  }
+};
+
+int main(int argc, char** argv)
+{
+  int nthreads = 1;
+  string jsonname("");
+
+  vector<string> args;
+  for(int i=1; i < argc; i++)
+    {
+      string arg(argv[i]);
+      if ( arg.size() < 2 || arg[0] != '-' )
+        {
+          args.push_back(arg);
+          continue;
+        }
+      if ( i + 1 >= argc )
+        {
+          cout << USAGE;
+          exit(1);
+        }
+      if ( arg == "-t" || arg == "--threads" )
+        nthreads = atoi(argv[++i]);
+      else if ( arg == "-j" || arg == "--json" )
+        jsonname = string(argv[++i]);
+      else
+        {
+          cout << "** hepmcstats: unknown option " << arg << endl << USAGE;
+          exit(1);
+        }
+    }
+  if ( args.size() < 1 )
+    {
+      cout << USAGE;
+      exit(0);
+    }
+
+  bool ok = true;
+  string json("[\n");
+  string delim("");
+  for(size_t i=0; i < args.size(); i++)
+    {
+      hepmcInput* input = openHepMC(args[i], nthreads);
+      if ( ! input->good() )
+        {
+          delete input;
+          ok = false;
+          continue;
+        }
+      hepmcStats stats(args[i]);
+      stats.scan(*input);
+      delete input;
+      if ( ! stats.good() ) ok = false;
+      stats.print();
+      json += delim + stats.json();
+      delim = ",\n";
+    }
+  json += "\n]\n";
+
+  if ( jsonname != "" )
+    {
+      FILE* file = fopen(jsonname.c_str(), "w");
+      bool written = file != 0 &&
+        fwrite(json.data(), 1, json.size(), file) == json.size();
+      if ( file != 0 && fclose(file) != 0 ) written = false;
+      if ( ! written )
+        {
+          cerr << "** hepmcstats: can't write " << jsonname << endl;
+          ok = false;
+        }
+    }
+  return ok ? 0 : 1;
+}
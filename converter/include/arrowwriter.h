@@ -0,0 +1,99 @@
+#ifndef ARROWWRITER_H
+#define ARROWWRITER_H
+//----------------------------------------------------------------------------
+// File: arrowwriter.h
+// Description: write a table to a file in the Arrow IPC file format (also
+//              known as Feather version 2), which pyarrow and pandas read
+//              directly, e.g., with pandas.read_feather(). The columns are
+//              filled a batch of rows at a time; each call to flush() writes
+//              the rows gathered so far as one record batch and empties the
+//              buffers, so that the memory used is bounded by the size of
+//              a batch. The columns have no null values.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstdio>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class arrowWriter
+{
+ public:
+  /// Column types.
+  enum type {INT8, INT16, INT32, INT64, FLOAT32, FLOAT64, LIST_INT32};
+
+  ///
+  arrowWriter(std::string filename);
+
+  ///
+  virtual ~arrowWriter();
+
+  /// True if all is well.
+  bool good() { return good_; }
+
+  /// Add a key, value pair to the metadata of the schema.
+  void metadata(std::string key, std::string value);
+
+  /// Add a column and return its index. Columns must be added before the
+  /// first flush().
+  int column(std::string name, type t);
+
+  /// Append n values to column c.
+  void append(int c, const void* values, size_t n);
+
+  /// Append n copies of value to column c.
+  void repeat(int c, const void* value, size_t n);
+
+  /** Append n lists to list column c. The values of list i are
+      values[offset[i]], ..., values[offset[i+1]-1], where offset[0] is 0
+      and offset[n] is taken to be nvalues.
+  */
+  void append(int c, const int* offset, size_t n,
+              const int* values, size_t nvalues);
+
+  /// Return number of rows gathered in column 0.
+  size_t rows();
+
+  /// Return number of bytes gathered in all columns.
+  size_t size();
+
+  /// Return number of bytes written to the file.
+  size_t bytes() { return position_; }
+
+  /// Write gathered rows as a record batch.
+  void flush();
+
+  /// Write remaining rows and the file footer, and close file.
+  void close();
+
+ private:
+  struct col
+  {
+    std::string name;
+    type t;
+    size_t rows;
+    std::vector<char> values;
+    std::vector<int32_t> offsets;
+  };
+
+  struct block
+  {
+    int64_t offset;
+    int32_t metadata;
+    int64_t body;
+  };
+
+  std::string filename_;
+  FILE* file_;
+  bool  good_;
+  bool  started_;
+  int64_t position_;
+  std::vector<col> col_;
+  std::vector<std::pair<std::string, std::string> > metadata_;
+  std::vector<block> block_;
+
+  void start();
+  void write(const void* data, size_t n);
+  void pad();
+};
+#endif
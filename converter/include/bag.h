@@ -0,0 +1,187 @@
+#ifndef BAG_H
+#define BAG_H
+//----------------------------------------------------------------------------
+// File: bag.h
+// Description: event struct filled by the HepMC parser. The names of the
+//              fields are those of the Bag struct declared in
+//              bin/hepmc2root.py, so that the Events tree written by the
+//              compiled converter can be read by the same eventBuffer.h
+//              analyzers. Unlike the Python Bag, the particle arrays are
+//              not limited to MAXPART entries; they grow to fit the
+//              largest event seen.
+//
+//              The complete daughter lists are stored in compressed sparse
+//              row form: the daughters of particle i are
+//
+//                Daughter_index[Particle_doffset[i]], ...,
+//                Daughter_index[Particle_doffset[i+1]-1]
+//
+//              where Particle_doffset[Event_numberP] is taken to be
+//              Event_numberD. Likewise, the mothers of particle i, that is,
+//              the incoming particles of its production vertex, are
+//              Mother_index[Particle_moffset[i]], ... with Event_numberM
+//              entries in all.
+//
+//              The vertices are also stored once each in the Vertex_
+//              arrays, of which there are Event_numberVX, including the
+//              implicit vertices of HepMC3; Particle_vertex is the index of
+//              the production vertex of a particle, or -1 if it has none.
+//
+//              Particle_pt, Particle_eta, Particle_phi and Particle_rapidity
+//              are derived from the momenta; they are filled only if the
+//              converter is asked to compute them (see kinematics.h).
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstddef>
+#include <vector>
+
+struct Bag
+{
+  ///
+  Bag(size_t n=1024)
+    : Event_numberD(0),
+      Event_numberM(0),
+      Event_numberVX(0),
+      Event_processID(0)
+  {
+    resize(n);
+    reserveDaughters(n);
+    reserveMothers(n);
+    reserveVertices(n);
+  }
+
+  /// Return number of particles the arrays can hold.
+  size_t capacity() { return Particle_x.size(); }
+
+  /// Make the arrays hold at least n particles. Return true if they moved.
+  bool reserve(size_t n)
+  {
+    if ( n <= capacity() ) return false;
+    size_t m = capacity() > 0 ? capacity() : 1;
+    while ( m < n ) m *= 2;
+    resize(m);
+    return true;
+  }
+
+  /// Make the daughter list hold at least n entries.
+  void reserveDaughters(size_t n) { reserveList(Daughter_index, n); }
+
+  /// Make the mother list hold at least n entries.
+  void reserveMothers(size_t n) { reserveList(Mother_index, n); }
+
+  /// Make the vertex arrays hold at least n vertices.
+  void reserveVertices(size_t n)
+  {
+    reserveList(Vertex_barcode, n);
+    reserveList(Vertex_x, n);
+    reserveList(Vertex_y, n);
+    reserveList(Vertex_z, n);
+    reserveList(Vertex_ctau, n);
+  }
+
+  // the scalars come first, so that they can be copied as a block
+  int    Event_number;
+  int    Event_numberMP;
+  double Event_scale;
+  double Event_alphaQCD;
+  double Event_alphaQED;
+  int    Event_barcodeSPV;
+  int    Event_numberV;
+  int    Event_barcodeBP1;
+  int    Event_barcodeBP2;
+  int    Event_numberP;
+
+  double Xsection_value;
+  double Xsection_error;
+
+  int    PDF_parton1;
+  int    PDF_parton2;
+  double PDF_x1;
+  double PDF_x2;
+  double PDF_Q2;
+  double PDF_x1f;
+  double PDF_x2f;
+  int    PDF_id1;
+  int    PDF_id2;
+
+  int    Event_numberD;
+  int    Event_numberM;
+  int    Event_numberVX;
+
+  // not in the Events tree, as in bin/hepmc2root.py, but in the tables of
+  // bin/hepmc2pandas.py
+  int    Event_processID;
+
+  std::vector<double> Particle_x;
+  std::vector<double> Particle_y;
+  std::vector<double> Particle_z;
+  std::vector<double> Particle_ctau;
+
+  std::vector<double> Particle_barcode;
+  std::vector<int>    Particle_pid;
+  std::vector<double> Particle_px;
+  std::vector<double> Particle_py;
+  std::vector<double> Particle_pz;
+  std::vector<double> Particle_energy;
+  std::vector<double> Particle_mass;
+  std::vector<int>    Particle_status;
+  std::vector<double> Particle_pt;
+  std::vector<double> Particle_eta;
+  std::vector<double> Particle_phi;
+  std::vector<double> Particle_rapidity;
+  std::vector<int>    Particle_d1;
+  std::vector<int>    Particle_d2;
+  std::vector<int>    Particle_m1;
+  std::vector<int>    Particle_m2;
+  std::vector<int>    Particle_doffset;
+  std::vector<int>    Particle_moffset;
+  std::vector<int>    Particle_vertex;
+
+  std::vector<int>    Daughter_index;
+  std::vector<int>    Mother_index;
+
+  std::vector<int>    Vertex_barcode;
+  std::vector<double> Vertex_x;
+  std::vector<double> Vertex_y;
+  std::vector<double> Vertex_z;
+  std::vector<double> Vertex_ctau;
+
+ private:
+  void resize(size_t n)
+  {
+    Particle_x.resize(n);
+    Particle_y.resize(n);
+    Particle_z.resize(n);
+    Particle_ctau.resize(n);
+
+    Particle_barcode.resize(n);
+    Particle_pid.resize(n);
+    Particle_px.resize(n);
+    Particle_py.resize(n);
+    Particle_pz.resize(n);
+    Particle_energy.resize(n);
+    Particle_mass.resize(n);
+    Particle_status.resize(n);
+    Particle_pt.resize(n);
+    Particle_eta.resize(n);
+    Particle_phi.resize(n);
+    Particle_rapidity.resize(n);
+    Particle_d1.resize(n);
+    Particle_d2.resize(n);
+    Particle_m1.resize(n);
+    Particle_m2.resize(n);
+    Particle_doffset.resize(n);
+    Particle_moffset.resize(n);
+    Particle_vertex.resize(n);
+  }
+
+  template <class T>
+  static void reserveList(std::vector<T>& list, size_t n)
+  {
+    if ( n <= list.size() ) return;
+    size_t m = list.size() > 0 ? list.size() : 1;
+    while ( m < n ) m *= 2;
+    list.resize(m);
+  }
+};
+#endif
@@ -0,0 +1,77 @@
+#ifndef BARCODEMAP_H
+#define BARCODEMAP_H
+//----------------------------------------------------------------------------
+// File: barcodemap.h
+// Description: open-addressing hash map from barcode to index, for use
+//              within one event. The table is reset per event by bumping a
+//              generation number rather than by clearing it, so that it is
+//              rebuilt without allocation once it is large enough for the
+//              largest event.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+class barcodeMap
+{
+ public:
+  ///
+  barcodeMap();
+
+  ///
+  virtual ~barcodeMap();
+
+  /// Remove all entries and make room for n of them.
+  void clear(size_t n);
+
+  /// Map barcode to index, replacing an existing entry.
+  void insert(int barcode, int index)
+  {
+    if ( 2 * (count_ + 1) > slot_.size() ) grow();
+    size_t i = locate(barcode);
+    if ( slot_[i].generation != generation_ )
+      {
+        slot_[i].generation = generation_;
+        slot_[i].barcode    = barcode;
+        count_++;
+      }
+    slot_[i].index = index;
+  }
+
+  /// Return index of barcode, or -1 if it is not found.
+  int find(int barcode) const
+  {
+    size_t i = locate(barcode);
+    return slot_[i].generation == generation_ ? slot_[i].index : -1;
+  }
+
+ private:
+  struct slot
+  {
+    uint32_t generation;
+    int      barcode;
+    int      index;
+  };
+
+  std::vector<slot> slot_;
+  size_t   mask_;
+  int      shift_;
+  size_t   count_;
+  uint32_t generation_;
+
+  /// Return slot that holds barcode or, if absent, the free slot for it.
+  size_t locate(int barcode) const
+  {
+    // Fibonacci hashing spreads consecutive barcodes over the table
+    size_t i = (uint32_t)((uint32_t)barcode * 2654435769u) >> shift_;
+    while ( slot_[i].generation == generation_ &&
+            slot_[i].barcode != barcode )
+      i = (i + 1) & mask_;
+    return i;
+  }
+
+  void resize(size_t n);
+  void grow();
+};
+#endif
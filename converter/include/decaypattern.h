@@ -0,0 +1,87 @@
+#ifndef DECAYPATTERN_H
+#define DECAYPATTERN_H
+//----------------------------------------------------------------------------
+// File: decaypattern.h
+// Description: match events against decay patterns, as in
+//              bin/hepmcfilter.py, e.g.,
+//
+//                35 15 -15, 35 6 -6
+//
+//              selects events in which the heavy neutral Higgs boson (35)
+//              decays to tau-/tau+ or to top/antitop. A decay is a parent
+//              followed by its daughters; the decays of the same parent,
+//              separated by commas, are alternatives, and an event is
+//              selected if each parent decays in at least one of its ways.
+//              A particle decays in a given way if the given daughters are
+//              distinct daughters of it; other daughters may be present.
+//
+//              In addition,
+//
+//                6 (24 -11 12) 5      a daughter in parentheses is itself
+//                                     a decay, which may be nested to any
+//                                     depth
+//                35 |15| |15|         |pid| matches the particle and its
+//                                     antiparticle
+//                6 (24 -11 12) 5 cc   cc after a decay also matches its
+//                                     charge conjugate, here
+//                                     -6 (-24 11 -12) -5
+//
+//              A particle that decays into a copy of itself, as it does in
+//              Pythia8 records whenever it recoils, is followed to its last
+//              copy. The pattern is compiled once into a list of nodes.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "bag.h"
+
+class decayPattern
+{
+ public:
+  ///
+  decayPattern(std::string pattern);
+
+  ///
+  virtual ~decayPattern();
+
+  /// True if the pattern is valid.
+  bool good() { return good_; }
+
+  /// True if the event in bag matches the pattern.
+  bool operator()(const Bag& bag) const;
+
+  /// Return the pattern as decoded.
+  std::string str() const;
+
+ private:
+  struct node
+  {
+    int pid;
+    bool any;                   // match particle and antiparticle
+    std::vector<int> daughter;  // nodes of the daughters
+  };
+
+  struct decay
+  {
+    int parent;                 // node of the parent
+    bool cc;                    // also match the charge conjugate
+  };
+
+  bool good_;
+  std::vector<node> node_;
+  // the decays of each distinct parent
+  std::vector<std::vector<decay> > decay_;
+
+  int  parse(const std::vector<std::string>& token, size_t& i);
+  std::string str(int n) const;
+
+  bool match(const Bag& bag, int n, int index, bool conjugate) const;
+  bool assign(const Bag& bag, const node& parent, size_t k,
+              int first, int last, bool conjugate,
+              std::vector<int>& used) const;
+  static int lastCopy(const Bag& bag, int index);
+};
+
+/// True if the particle with the given PDG id is its own antiparticle.
+bool selfConjugate(int pid);
+#endif
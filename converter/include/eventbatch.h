@@ -0,0 +1,83 @@
+#ifndef EVENTBATCH_H
+#define EVENTBATCH_H
+//----------------------------------------------------------------------------
+// File: eventbatch.h
+// Description: a batch of events stored column-wise. The particles of all
+//              events are concatenated, so a batch holds only the particles
+//              actually present rather than the capacity of the bag.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <vector>
+#include "bag.h"
+
+class eventBatch
+{
+ public:
+  ///
+  eventBatch();
+
+  ///
+  virtual ~eventBatch();
+
+  /// Remove all events, but keep the memory.
+  void clear();
+
+  /// Return number of events.
+  size_t size() { return offset_.size(); }
+
+  /// Append a copy of the event in the given bag.
+  void append(Bag& bag);
+
+  /// Copy event i to the given bag.
+  void get(size_t i, Bag& bag);
+
+  /// Also copy Particle_pt, Particle_eta, Particle_phi and Particle_rapidity
+  /// if on.
+  void setKinematics(bool on) { kinematics_ = on; }
+
+ private:
+  bool kinematics_;
+
+  // the scalars are the part of the Bag before the particle arrays
+  std::vector<char>   scalars_;
+  std::vector<size_t> offset_;
+
+  std::vector<double> Particle_x;
+  std::vector<double> Particle_y;
+  std::vector<double> Particle_z;
+  std::vector<double> Particle_ctau;
+
+  std::vector<double> Particle_barcode;
+  std::vector<int>    Particle_pid;
+  std::vector<double> Particle_px;
+  std::vector<double> Particle_py;
+  std::vector<double> Particle_pz;
+  std::vector<double> Particle_energy;
+  std::vector<double> Particle_mass;
+  std::vector<int>    Particle_status;
+  std::vector<int>    Particle_d1;
+  std::vector<int>    Particle_d2;
+  std::vector<int>    Particle_m1;
+  std::vector<int>    Particle_m2;
+  std::vector<int>    Particle_doffset;
+  std::vector<int>    Particle_moffset;
+  std::vector<int>    Particle_vertex;
+
+  std::vector<double> Particle_pt;
+  std::vector<double> Particle_eta;
+  std::vector<double> Particle_phi;
+  std::vector<double> Particle_rapidity;
+
+  std::vector<size_t> doffset_;
+  std::vector<int>    Daughter_index;
+  std::vector<size_t> moffset_;
+  std::vector<int>    Mother_index;
+
+  std::vector<size_t> voffset_;
+  std::vector<int>    Vertex_barcode;
+  std::vector<double> Vertex_x;
+  std::vector<double> Vertex_y;
+  std::vector<double> Vertex_z;
+  std::vector<double> Vertex_ctau;
+};
+#endif
@@ -0,0 +1,98 @@
+#ifndef HEPMCARROW_H
+#define HEPMCARROW_H
+//----------------------------------------------------------------------------
+// File: hepmcarrow.h
+// Description: write the contents of a Bag to two Arrow IPC (Feather)
+//              files: an events table, with one row per event and a column
+//              for each of the Event_, Xsection_ and PDF_ variables, and a
+//              particles table, with one row per particle, keyed by the
+//              column Event_number. The particles table has a column for
+//              each Particle_ variable, while the daughter and mother lists
+//              are the list columns Particle_daughters and Particle_mothers.
+//
+//              Events are gathered into record batches of a fixed number of
+//              events, or fewer if the particles of the batch exceed a
+//              given size, so that the memory used does not grow with the
+//              number of events.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <functional>
+#include <string>
+#include <vector>
+#include "arrowwriter.h"
+#include "bag.h"
+#include "hepmcoutput.h"
+
+class hepmcArrow : public hepmcOutput
+{
+ public:
+  /** Write events to filename and particles to the same name with the
+      extension .arrow replaced by .particles.arrow. Add the columns
+      Particle_pt, Particle_eta, Particle_phi and Particle_rapidity if
+      kinematics is true.
+  */
+  hepmcArrow(std::string filename, Bag& bag, std::string version,
+             bool kinematics=false);
+
+  ///
+  virtual ~hepmcArrow();
+
+  /// Add current contents of bag to the record batches.
+  void fill();
+
+  /// Write a record batch every n events (default 1000).
+  void setFlush(long long n);
+
+  /// Write remaining record batches and close files.
+  void close();
+
+  /// Return number of events written.
+  long long entries();
+
+  /// Return number of bytes written to the two files.
+  long long bytes();
+
+  /// List columns.
+  void ls();
+
+  /// Return name of the particles file for the given events file.
+  static std::string particleFile(std::string filename);
+
+ private:
+  Bag* bag_;
+  arrowWriter events_;
+  arrowWriter particles_;
+  long long batch_;
+  size_t maxsize_;
+  long long entries_;
+
+  struct scalar
+  {
+    int column;
+    void* address;
+  };
+  std::vector<scalar> scalar_;
+
+  struct array
+  {
+    int column;
+    std::function<const void*()> address;
+  };
+  std::vector<array> array_;
+
+  int key_;
+  int daughters_;
+  int mothers_;
+  std::vector<std::string> ls_;
+
+  /// Add a column to the events table.
+  template <class T>
+  void add(std::string name, T* address);
+
+  /// Add a column to the particles table.
+  template <class T>
+  void add(std::string name, std::vector<T>& array);
+
+  void flush();
+};
+#endif
@@ -0,0 +1,127 @@
+#ifndef HEPMCCOLUMNS_H
+#define HEPMCCOLUMNS_H
+//----------------------------------------------------------------------------
+// File: hepmccolumns.h
+// Description: read the events of a HepMC file a chunk at a time into
+//              typed columns, for use by bin/hepmc2pandas.py through the
+//              C functions declared below. The columns of the events table
+//              have one value per event and are named as in the erec
+//              dictionary of hepmc2pandas.py; those of the particles table
+//              have one value per particle, are named as in its prec
+//              dictionary, and include the event number Event_number. The
+//              memory of the columns is reused from one chunk to the next.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <functional>
+#include <string>
+#include <vector>
+#include "bag.h"
+#include "hepmcconverter.h"
+#include "hepmcinput.h"
+
+class hepmcColumns
+{
+ public:
+  /// Tables.
+  enum {EVENTS, PARTICLES};
+
+  /** Open file. If kinematics is true, the particles table includes the
+      columns Particle_pt, Particle_eta, Particle_phi and Particle_rapidity
+      (see kinematics.h).
+  */
+  hepmcColumns(std::string filename, int nthreads=1, bool kinematics=false);
+
+  ///
+  virtual ~hepmcColumns();
+
+  /// True if all is well.
+  bool good();
+
+  /// Return HepMC version given in header.
+  std::string version() { return input_->version(); }
+
+  /// Read the next n events into the columns. Return number read.
+  long read(long n);
+
+  /// Return number of columns.
+  size_t size() { return column_.size(); }
+
+  /// Return name of column c.
+  std::string name(size_t c) { return column_[c].name; }
+
+  /// Return type of column c: 'i' (int32) or 'd' (float64).
+  char type(size_t c) { return column_[c].type; }
+
+  /// Return table of column c.
+  int table(size_t c) { return column_[c].table; }
+
+  /// Return number of rows of the given table.
+  size_t rows(int table) { return rows_[table]; }
+
+  /// Return values of column c.
+  const void* data(size_t c) { return column_[c].values.data(); }
+
+ private:
+  hepmcInput* input_;
+  Bag bag_;
+  hepmcConverter* convert_;
+  size_t rows_[2];
+
+  struct column
+  {
+    std::string name;
+    char type;
+    int  table;
+    std::function<void(std::vector<char>&)> append;
+    std::vector<char> values;
+  };
+  std::vector<column> column_;
+
+  /// Add an event column.
+  template <class T>
+  void add(std::string name, T* address);
+
+  /// Add a particle column of type U taken from an array of type T.
+  template <class U, class T>
+  void add(std::string name, std::vector<T>& array);
+
+  /// Add a column with the event number of each particle.
+  void key();
+};
+
+// C interface, used through ctypes
+extern "C"
+{
+  /** Open file, with the derived kinematic columns if kinematics is not
+      0. Return 0 if it can't be read.
+  */
+  void*       hepmc_open(const char* filename, int nthreads, int kinematics);
+
+  ///
+  void        hepmc_close(void* columns);
+
+  ///
+  const char* hepmc_version(void* columns);
+
+  /// Read the next n events. Return number read, or -1 on error.
+  long        hepmc_read(void* columns, long n);
+
+  ///
+  int         hepmc_columns(void* columns);
+
+  ///
+  const char* hepmc_name(void* columns, int c);
+
+  ///
+  char        hepmc_type(void* columns, int c);
+
+  ///
+  int         hepmc_table(void* columns, int c);
+
+  ///
+  long        hepmc_rows(void* columns, int table);
+
+  /// Copy the values of column c to buffer.
+  void        hepmc_copy(void* columns, int c, void* buffer);
+}
+#endif
@@ -0,0 +1,128 @@
+#ifndef HEPMCCONVERTER_H
+#define HEPMCCONVERTER_H
+//----------------------------------------------------------------------------
+// File: hepmcconverter.h
+// Description: deliver the events of a HepMC input, one at a time and in
+//              their original order, to a bag. With more than one thread,
+//              the input is split at event boundaries into chunks that are
+//              parsed concurrently on a thread pool; the parsed chunks are
+//              handed out strictly in input order, so the result is
+//              identical to that of a serial conversion.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <deque>
+#include <future>
+#include <vector>
+#include "bag.h"
+#include "decaypattern.h"
+#include "eventbatch.h"
+#include "hepmcinput.h"
+#include "hepmcparser.h"
+#include "threadpool.h"
+
+class hepmcConverter
+{
+ public:
+  ///
+  hepmcConverter(hepmcInput& input, Bag& bag,
+                 int nthreads=1, size_t chunksize=1 << 24);
+
+  ///
+  virtual ~hepmcConverter();
+
+  /// False if a faulty event record was found or the input failed.
+  bool good() { return good_; }
+
+  /// Copy next event to bag. Return false at end of input or on error.
+  bool next();
+
+  /** Store at most n particles per event, keeping the most important
+      ones (see hepmcParser::setLimit). Call before the first next().
+  */
+  void setLimit(int n);
+
+  /** Store only the particles that pass the given selection (see
+      hepmcParser::setSelection). Call before the first next().
+  */
+  void setSelection(const particleSelection* select);
+
+  /** Compute Particle_pt, Particle_eta, Particle_phi and Particle_rapidity
+      (see kinematics.h). Call before the first next().
+  */
+  void setKinematics(bool on);
+
+  /** Deliver only the events that match the given decay pattern, which
+      must outlive the converter (0 to deliver all). The pattern is
+      matched on the parsing threads. Call before the first next().
+  */
+  void setPattern(const decayPattern* pattern);
+
+  /// Return number of events delivered so far.
+  long long events() { return events_; }
+
+  /// Return number of events parsed so far, delivered or not.
+  long long scanned() { return scanned_; }
+
+  /** Get byte range [begin, end) of the record of the event last
+      delivered. The range remains valid until the next call to next().
+  */
+  void range(const char*& begin, const char*& end);
+
+  /** Return byte offset in the input of the end of the record of the
+      event last delivered, that is, the offset from which a later
+      conversion can continue (see hepmcInput::seek).
+  */
+  size_t position();
+
+  /** Return seconds spent so far in the read, parse, select, link,
+      kinematics, batch and wait stages (see hepmcmonitor.h).
+  */
+  stageTimes times();
+
+ private:
+  struct chunk
+  {
+    chunk()
+      : begin(0), end(0), position(0), bag(new Bag()), pattern(0),
+        scanned(0), append(0), ok(true) {}
+    ~chunk() { delete bag; }
+    std::vector<char> buffer;
+    const char* begin;
+    const char* end;
+    size_t position; // input offset of end
+    Bag* bag;
+    hepmcParser parse;
+    const decayPattern* pattern;
+    eventBatch batch;
+    std::vector<std::pair<const char*, const char*> > range;
+    long long scanned;
+    double append; // seconds spent appending to batch
+    bool ok;
+  };
+
+  hepmcInput* input_;
+  Bag* bag_;
+  bool good_;
+  long long events_;
+  long long scanned_;
+  stageTimes times_;
+
+  hepmcParser parse_;
+  const decayPattern* pattern_;
+  const char* begin_;
+  const char* end_;
+  size_t position_;
+
+  // parallel mode
+  threadPool* pool_;
+  size_t chunksize_;
+  std::vector<chunk*> free_;
+  std::deque<std::pair<chunk*, std::future<bool> > > busy_;
+  chunk* current_;
+  size_t entry_;
+  bool eof_;
+  bool failed_; // input failed
+
+  static bool parseChunk(chunk* c);
+};
+#endif
@@ -0,0 +1,111 @@
+#ifndef HEPMCINDEX_H
+#define HEPMCINDEX_H
+//----------------------------------------------------------------------------
+// File: hepmcindex.h
+// Description: persistent byte-offset index of the events in a HepMC file.
+//              The index is built in a single scan of the mapped file, which
+//              looks only at line keys, and is saved to a sidecar file
+//              <HepMC-file>.idx. The sidecar records the size and the
+//              modification time of the HepMC file, so a stale index is
+//              detected and rebuilt.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "hepmcinput.h"
+#include "hepmcmap.h"
+
+/// Location and size of an event.
+struct indexEntry
+{
+  uint64_t offset;    /// byte offset of "E" line
+  int32_t  number;    /// event number
+  int32_t  numberP;   /// number of particles
+  int32_t  numberV;   /// number of vertices
+  int32_t  reserved;
+};
+
+class hepmcIndex
+{
+ public:
+  ///
+  hepmcIndex();
+
+  ///
+  virtual ~hepmcIndex();
+
+  /// Scan the mapped file and index all its events.
+  void build(hepmcMap& input);
+
+  /// Load index from file. Return false if it is missing or stale.
+  bool load(std::string indexfile, std::string hepmcfile);
+
+  /// Save index to file.
+  bool save(std::string indexfile, std::string hepmcfile);
+
+  /// Return number of events.
+  size_t size() { return entry_.size(); }
+
+  /// Return entry for event at given ordinal position.
+  indexEntry& operator[](size_t i) { return entry_[i]; }
+
+  /// Return byte offset of end of event at given ordinal position.
+  uint64_t end(size_t i)
+  {
+    return i + 1 < entry_.size() ? entry_[i+1].offset : end_;
+  }
+
+  /// Return ordinal position of given event number, or size() if not found.
+  size_t find(int number);
+
+ private:
+  std::vector<indexEntry> entry_;
+  uint64_t end_;
+};
+
+/// Return name of index file for given HepMC file.
+std::string indexName(std::string filename);
+
+/** Return the index of the given mapped HepMC file. The index is loaded
+    from the sidecar file if it is up to date; otherwise it is built and
+    saved.
+*/
+hepmcIndex* openIndex(hepmcMap& input, std::string filename);
+
+/** Return the ordinal positions of count events starting at event first;
+    a negative count means all remaining events. If sample > 0, return a
+    random subset of sample of these events, still in file order.
+*/
+std::vector<size_t> selectEvents(size_t size, long long first,
+                                 long long count=-1, long long sample=0,
+                                 unsigned int seed=42);
+
+/// Model an input that delivers the events at the given ordinal positions.
+class hepmcIndexedInput : public hepmcInput
+{
+ public:
+  ///
+  hepmcIndexedInput(hepmcMap& input, hepmcIndex& index,
+                    std::vector<size_t>& events);
+
+  ///
+  virtual ~hepmcIndexedInput();
+
+  /// Get byte range [begin, end) of next event. Return false when done.
+  bool read(const char*& begin, const char*& end);
+
+  /** Get byte range [begin, end) of events that span at least nbytes. If
+      these events are contiguous in the file the range points into the
+      mapping, otherwise they are copied to the buffer.
+  */
+  bool read(const char*& begin, const char*& end, size_t nbytes,
+            std::vector<char>& buffer);
+
+ private:
+  hepmcMap*   input_;
+  hepmcIndex* index_;
+  std::vector<size_t> events_;
+  size_t next_;
+};
+#endif
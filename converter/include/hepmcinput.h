@@ -0,0 +1,97 @@
+#ifndef HEPMCINPUT_H
+#define HEPMCINPUT_H
+//----------------------------------------------------------------------------
+// File: hepmcinput.h
+// Description: model an input of HepMC events. Each call to read() returns
+//              the byte range of the next event, from its "E" line up to
+//              (but excluding) the next "E" line or the end of listing. The
+//              range is a view into the input; no line is copied.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+
+/** Return pointer to the start of the first event line (a line beginning
+    with "E ") at or after p, where p must be the start of a line. Return
+    end if there is none.
+*/
+const char* findEvent(const char* p, const char* end);
+
+/** Return pointer to the start of the trailing HepMC::...END_EVENT_LISTING
+    line in [p, end), or end if there is none.
+*/
+const char* findTrailer(const char* p, const char* end);
+
+class hepmcInput
+{
+ public:
+  ///
+  hepmcInput();
+
+  ///
+  virtual ~hepmcInput();
+
+  /// True if all is well.
+  bool good() { return good_; }
+
+  /// Return HepMC version given in header.
+  std::string version() { return version_; }
+
+  /// Return format of the event records: 2 (IO_GenEvent) or 3 (Asciiv3).
+  int format() { return format_; }
+
+  /// Return header, that is, all lines before the first event.
+  std::string header() { return header_; }
+
+  /** Return trailer, that is, the END_EVENT_LISTING line and whatever
+      follows it. It is known once the last event has been read, and is
+      empty if the input has none.
+  */
+  std::string trailer() { return trailer_; }
+
+  /** Return byte offset of the next event to be read, counted from the
+      start of the (decompressed) input.
+  */
+  size_t position() { return position_; }
+
+  /** Move to the event at the given byte offset, as returned earlier by
+      position(), skipping the events before it. The skipped events are
+      found by the boundary scan and are not parsed. Return false if there
+      is no event boundary at that offset.
+  */
+  virtual bool seek(size_t offset);
+
+  /** Get byte range [begin, end) of next event. The range remains valid
+      until the next call to read(). Return false at end of input.
+  */
+  virtual bool read(const char*& begin, const char*& end) = 0;
+
+  /** Get byte range [begin, end) of as many complete events as are needed
+      to span at least nbytes. The events are copied to the given buffer
+      unless the input guarantees that its ranges remain valid, in which
+      case the buffer is not used. Return false at end of input.
+  */
+  virtual bool read(const char*& begin, const char*& end, size_t nbytes,
+                    std::vector<char>& buffer);
+
+ protected:
+  bool good_;
+  std::string version_;
+  std::string header_;
+  std::string trailer_;
+  int format_;
+  size_t position_;
+
+  /** Decode header in [begin, end), which must extend to the first event,
+      if any. Return false if this is not a HepMC file.
+  */
+  bool decodeHeader(const char* begin, const char* end);
+};
+
+/** Open a HepMC file. Regular files are memory mapped. Compressed files,
+    which are decompressed on a separate thread (and frames of zstd files
+    on nthreads threads), pipes and standard input ("-") are read through
+    a buffered stream.
+*/
+hepmcInput* openHepMC(std::string filename, int nthreads=1);
+#endif
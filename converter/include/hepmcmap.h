@@ -0,0 +1,50 @@
+#ifndef HEPMCMAP_H
+#define HEPMCMAP_H
+//----------------------------------------------------------------------------
+// File: hepmcmap.h
+// Description: memory mapped input of HepMC events. The whole file is
+//              mapped read-only and the kernel is advised that it will be
+//              read sequentially. The event ranges returned by read() point
+//              into the mapping and remain valid for the lifetime of the
+//              object.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include "hepmcinput.h"
+
+class hepmcMap : public hepmcInput
+{
+ public:
+  ///
+  hepmcMap(std::string filename);
+
+  ///
+  virtual ~hepmcMap();
+
+  /// Get byte range [begin, end) of next event. Return false at end of file.
+  bool read(const char*& begin, const char*& end);
+
+  /** Get byte range [begin, end) of the complete events that span at least
+      nbytes. The range points into the mapping; the buffer is not used.
+  */
+  bool read(const char*& begin, const char*& end, size_t nbytes,
+            std::vector<char>& buffer);
+
+  /// Start of mapping.
+  const char* data() { return data_; }
+
+  /// Size of mapping in bytes.
+  size_t size() { return size_; }
+
+  /// Byte offset of first event.
+  size_t first() { return first_; }
+
+  /// Move to the event at the given byte offset, without a scan.
+  bool seek(size_t offset);
+
+ private:
+  const char* data_;
+  size_t size_;
+  size_t first_;
+};
+#endif
@@ -0,0 +1,118 @@
+#ifndef HEPMCMONITOR_H
+#define HEPMCMONITOR_H
+//----------------------------------------------------------------------------
+// File: hepmcmonitor.h
+// Description: timers and counters of the stages of a conversion. The
+//              parser, the converter and the outputs time their own
+//              stages; the monitor combines these times with the number of
+//              events, particles and bytes into progress lines and a report
+//              in JSON. The stages that run on the parsing threads (parse,
+//              select, link and half of batch) are summed over the threads,
+//              so with several threads their sum may exceed the elapsed
+//              time; the main thread then spends its time in read, wait,
+//              fill and write.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <chrono>
+#include <string>
+
+/// Return seconds on a monotonic clock.
+inline double seconds()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                       .time_since_epoch()).count();
+}
+
+/// Seconds spent in each stage of a conversion.
+struct stageTimes
+{
+  stageTimes()
+    : read(0), parse(0), select(0), link(0), kinematics(0), batch(0),
+      wait(0), fill(0), write(0) {}
+
+  double read;   ///< reading, and decompressing, the input
+  double parse;  ///< tokenizing the records into the bag
+  double select; ///< dropping particles (--select, --max-particles)
+  double link;   ///< building the daughter, mother and vertex lists
+  double kinematics; ///< computing pt, eta, phi and rapidity
+  double batch;  ///< copying events into and out of batches (threads)
+  double wait;   ///< waiting for the parsing threads
+  double fill;   ///< copying the bag to the buffers of the output
+  double write;  ///< serializing, compressing and writing the output
+
+  void add(const stageTimes& t)
+  {
+    read   += t.read;
+    parse  += t.parse;
+    select += t.select;
+    link   += t.link;
+    kinematics += t.kinematics;
+    batch  += t.batch;
+    wait   += t.wait;
+    fill   += t.fill;
+    write  += t.write;
+  }
+};
+
+/// Return peak resident set size of this process in bytes.
+long long peakRSS();
+
+class hepmcMonitor
+{
+ public:
+  /** Start the clock. If a report file is given, the report is rewritten
+      there at most every interval seconds while the conversion runs, and
+      once more at the end.
+  */
+  hepmcMonitor(std::string input, std::string output, int nthreads,
+               std::string report="", double interval=10);
+
+  ///
+  virtual ~hepmcMonitor();
+
+  /// True if all is well.
+  bool good() { return good_; }
+
+  /// Count an event with n particles.
+  void count(int n)
+  {
+    events_++;
+    particles_ += n;
+  }
+
+  /// Return number of events counted.
+  long long events() { return events_; }
+
+  /** Record the stage times and the bytes read and written so far, print
+      a progress line and, if it is due, rewrite the report.
+  */
+  void update(const stageTimes& times, long long bytesin, long long bytesout);
+
+  /// Print summary of the completed conversion and write the final report.
+  void finish(const stageTimes& times, long long bytesin, long long bytesout,
+              bool ok);
+
+  /// Return report in JSON.
+  std::string json(bool final);
+
+ private:
+  bool good_;
+  std::string input_;
+  std::string output_;
+  int nthreads_;
+  std::string report_;
+  double interval_;
+  double start_;
+  double elapsed_;
+  double written_; // time of the last report
+  long long events_;
+  long long particles_;
+  long long bytesin_;
+  long long bytesout_;
+  stageTimes times_;
+  bool ok_;
+
+  void record(const stageTimes& times, long long bytesin, long long bytesout);
+  void write(bool final);
+};
+#endif
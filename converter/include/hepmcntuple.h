@@ -0,0 +1,127 @@
+#ifndef HEPMCNTUPLE_H
+#define HEPMCNTUPLE_H
+//----------------------------------------------------------------------------
+// File: hepmcntuple.h
+// Description: write the contents of a Bag to the Events RNTuple. The
+//              Event_, Xsection_ and PDF_ variables are scalar fields with
+//              the names of the branches of the Events tree. The Particle_
+//              variables are the members of a single collection, Particle,
+//              so that they share one offset column, e.g., the x position
+//              of particles is the field Particle.Particle_x. Likewise, the
+//              daughter and mother lists are the collections Daughter and
+//              Mother, with members Daughter_index and Mother_index.
+//
+//              RNTuple output needs ROOT 6.36 or later; without it (when
+//              HAVE_RNTUPLE is not defined) the output reports an error.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "bag.h"
+#include "hepmcoutput.h"
+#ifdef HAVE_RNTUPLE
+#include "ROOT/RField.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleWriter.hxx"
+#endif
+
+class hepmcNtuple : public hepmcOutput
+{
+ public:
+  /** Add the fields Particle_pt, Particle_eta, Particle_phi and
+      Particle_rapidity to the Particle collection if kinematics is true.
+  */
+  hepmcNtuple(std::string filename, Bag& bag, std::string version,
+              bool kinematics=false, std::string ntuplename="Events");
+
+  ///
+  virtual ~hepmcNtuple();
+
+  /// Fill ntuple with current contents of bag.
+  void fill();
+
+  /// Compress pages on n threads, using ROOT implicit multithreading.
+  void setThreads(int n);
+
+  /// Set ROOT compression settings, e.g., 505 (zstd, level 5).
+  void setCompression(int settings);
+
+  /// Commit a cluster every n entries. If n <= 0, use the ROOT defaults.
+  void setFlush(long long n);
+
+  /// Write ntuple and close file.
+  void close();
+
+  /// Return number of entries written.
+  long long entries();
+
+  /// Return size of the file so far.
+  long long bytes();
+
+  /// List fields.
+  void ls();
+
+#ifdef HAVE_RNTUPLE
+ private:
+  std::string filename_;
+  std::string ntuplename_;
+  int    compression_;
+  long long flush_;
+  long long entries_;
+
+  std::unique_ptr<ROOT::RNTupleModel>  model_;
+  std::unique_ptr<ROOT::RNTupleWriter> writer_;
+  std::unique_ptr<ROOT::REntry>        entry_;
+
+  struct scalar
+  {
+    std::string name;
+    void* address;
+  };
+  std::vector<scalar> scalar_;
+
+  /// A member of a collection, copied to the record buffer at each fill.
+  struct member
+  {
+    std::function<const void*()> address;
+    void (*copy)(char*, size_t, const void*, int);
+    size_t offset;
+  };
+
+  /** A collection of records, which RNTuple stores column-wise. The buffer
+      is laid out as the std::vector of records expected by the field.
+  */
+  struct collection
+  {
+    std::string name;
+    int* count;
+    std::vector<std::unique_ptr<ROOT::RFieldBase> > fields;
+    std::vector<member> members;
+    size_t size;
+    std::vector<char> buffer;
+  };
+  std::vector<collection> collection_;
+
+  std::vector<std::string> ls_;
+
+  /// Add a scalar field.
+  template <class T>
+  void add(std::string name, T* address);
+
+  /// Add a member to the last collection.
+  template <class T>
+  void add(std::string name, std::vector<T>& array);
+
+  /// Start a collection of count records.
+  void begin(std::string name, int* count);
+
+  /// Add the fields of the last collection to the model.
+  void end();
+
+  /// Create the writer from the model.
+  void open();
+#endif
+};
+#endif
@@ -0,0 +1,84 @@
+#ifndef HEPMCOUTPUT_H
+#define HEPMCOUTPUT_H
+//----------------------------------------------------------------------------
+// File: hepmcoutput.h
+// Description: model an output of converted events. Each call to fill()
+//              writes the current contents of the Bag given to the output
+//              when it was created.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include "bag.h"
+
+class hepmcOutput
+{
+ public:
+  ///
+  hepmcOutput();
+
+  ///
+  virtual ~hepmcOutput();
+
+  /// True if all is well.
+  bool good() { return good_; }
+
+  /// Write current contents of bag.
+  virtual void fill() = 0;
+
+  /// Compress on n threads.
+  virtual void setThreads(int n) {}
+
+  /// Set ROOT compression settings (100 * algorithm + level).
+  virtual void setCompression(int settings) {}
+
+  /** Make the entries written so far readable every n entries. If n <= 0,
+      use the defaults of the output.
+  */
+  virtual void setFlush(long long n) {}
+
+  /** Make the entries written so far durable and save with them the given
+      resume point, from which a later job can continue to fill the output
+      (see openOutput). Return false if the output cannot do this.
+  */
+  virtual bool checkpoint(std::string point) { return false; }
+
+  /// Return resume point saved with the entries of a resumed output.
+  virtual std::string resumePoint() { return ""; }
+
+  /// Write remaining entries and close file.
+  virtual void close() = 0;
+
+  /// Return number of entries written.
+  virtual long long entries() = 0;
+
+  /// Return number of bytes written to the file(s) so far.
+  virtual long long bytes() { return 0; }
+
+  /** Return seconds spent so far in serializing, compressing and writing
+      the entries, as opposed to copying them from the bag.
+  */
+  double writeTime() { return write_; }
+
+  /// List branches or fields.
+  virtual void ls() {}
+
+ protected:
+  bool good_;
+  double write_;
+};
+
+/** Open an output for the events in bag. The format is "tree" (the Events
+    TTree of bin/hepmc2root.py), "rntuple" (an Events RNTuple with the
+    same field names) or "arrow" (Arrow IPC files of events and particles).
+    The schema, e.g., "compact16,pidcode", applies to the TTree only (see
+    hepmctree.h), except for "kinematics", which adds the Particle_pt,
+    Particle_eta, Particle_phi and Particle_rapidity columns to any format;
+    the converter must be asked to compute them. If resume is true, the
+    output, which must be a TTree saved by checkpoint(), is reopened and
+    further entries are appended to those saved.
+*/
+hepmcOutput* openOutput(std::string filename, Bag& bag, std::string version,
+                        std::string format="tree",
+                        std::string schema="full",
+                        bool resume=false);
+#endif
@@ -0,0 +1,156 @@
+#ifndef HEPMCPARSER_H
+#define HEPMCPARSER_H
+//----------------------------------------------------------------------------
+// File: hepmcparser.h
+// Description: parse HepMC2 and HepMC3 event records in place, that is,
+//              without splitting lines into strings. Integers and floats
+//              are converted with std::from_chars, which neither allocates
+//              nor consults the locale. Both formats are parsed into the
+//              same Bag.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <charconv>
+#include <string>
+#include <vector>
+#include "bag.h"
+#include "barcodemap.h"
+#include "hepmcmonitor.h"
+#include "particleselection.h"
+
+/// Skip blanks.
+inline const char* skipSpace(const char* p, const char* end)
+{
+  while ( p < end && (*p == ' ' || *p == '\t') ) p++;
+  return p;
+}
+
+/// Move to start of next line.
+inline const char* nextLine(const char* p, const char* end)
+{
+  while ( p < end && *p != '\n' ) p++;
+  return p < end ? p + 1 : end;
+}
+
+/** Decode the next blank-separated field as a number. Return the position
+    after the field, or 0 if the field is not a number (or p is 0).
+*/
+template <class T>
+inline const char* getField(const char* p, const char* end, T& x)
+{
+  if ( p == 0 ) return 0;
+  p = skipSpace(p, end);
+  std::from_chars_result r = std::from_chars(p, end, x);
+  return r.ec == std::errc() ? r.ptr : 0;
+}
+
+/// Skip the next blank-separated field.
+inline const char* skipField(const char* p, const char* end)
+{
+  if ( p == 0 ) return 0;
+  p = skipSpace(p, end);
+  while ( p < end && *p != ' ' && *p != '\t' && *p != '\n' ) p++;
+  return p;
+}
+
+class hepmcParser
+{
+ public:
+  ///
+  hepmcParser();
+
+  ///
+  virtual ~hepmcParser();
+
+  /** Parse the event in the byte range [begin, end), which must start with
+      its "E" line, into the given bag. Return false if the record is faulty.
+  */
+  bool operator()(const char* begin, const char* end, Bag& bag);
+
+  /// Set format of the event records: 2 (IO_GenEvent) or 3 (Asciiv3).
+  void setFormat(int format) { format_ = format; }
+
+  /** Store at most n particles per event (no limit if n <= 0). The
+      particles of larger events are kept in order of priority: first the
+      final-state particles, then the beams and the particles of the hard
+      process, then the others, each in file order. The daughter and
+      mother indices are renumbered and point only to kept particles: the
+      daughters of a particle are its nearest kept descendants and its
+      mothers its nearest kept ancestors.
+  */
+  void setLimit(int n) { limit_ = n; }
+
+  /** Store only the particles that pass the given selection, which must
+      outlive the parser (0 to store all). It is applied before the limit
+      of setLimit and links the kept particles in the same way.
+  */
+  void setSelection(const particleSelection* select) { select_ = select; }
+
+  /** Compute Particle_pt, Particle_eta, Particle_phi and Particle_rapidity
+      of the stored particles if on (see kinematics.h).
+  */
+  void setKinematics(bool on) { kinematics_ = on; }
+
+  /// Return seconds spent so far in the parse, select, link and kinematics
+  /// stages.
+  const stageTimes& times() { return times_; }
+
+  /// Reset the times.
+  void clearTimes() { times_ = stageTimes(); }
+
+ private:
+  int format_;
+  int limit_;
+  const particleSelection* select_;
+  bool kinematics_;
+  stageTimes times_;
+
+  // per particle
+  std::vector<int> pvertex_;  // vertex field of the P record
+  std::vector<int> prodv_;    // production vertex or -1
+  std::vector<int> endv_;     // end vertex or -1
+
+  // vertices are numbered 0, 1,.. in the order of their records
+  barcodeMap vertex_;         // vertex barcode to vertex number
+  int nvertex_;
+
+  // HepMC3
+  barcodeMap particle_;       // particle id to index
+  std::vector<int>    implicit_;  // implicit end vertex of particle or -1
+  std::vector<int>    vfirst_;    // incoming particle that places vertex
+  std::vector<char>   vset_;      // true if vertex has a position
+  std::vector<std::pair<int, int> > incoming_; // particle id, vertex
+
+  // per vertex, in both formats
+  std::vector<int>    vbarcode_;  // barcode (HepMC2), id (HepMC3) or 0
+  std::vector<double> vposition_; // x, y, z, t of vertex
+
+  // particles sorted by vertex, in compressed sparse row form
+  std::vector<int> vin_;
+  std::vector<int> vout_;
+  std::vector<int> vnext_;
+  std::vector<int> vinlist_;
+  std::vector<int> voutlist_;
+
+  std::vector<int> kept_;
+
+  // vertices merged by dropping particles, as a union-find forest
+  bool merged_;
+  std::vector<int> vroot_;
+  std::vector<int> vused_;
+  std::vector<int> mprodv_;
+  std::vector<int> mendv_;
+
+  bool fail(const char* p, const char* end);
+  void clear(Bag& bag);
+  void reserve(Bag& bag, int index);
+  void newVertex();
+  bool parse2(const char* begin, const char* end, Bag& bag);
+  bool parse3(const char* begin, const char* end, Bag& bag);
+  void link(Bag& bag);
+  void vertices(Bag& bag);
+  int  root(int v);
+  void select(Bag& bag);
+  void truncate(Bag& bag);
+  void drop(Bag& bag);
+};
+#endif
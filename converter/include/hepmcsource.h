@@ -0,0 +1,170 @@
+#ifndef HEPMCSOURCE_H
+#define HEPMCSOURCE_H
+//----------------------------------------------------------------------------
+// File: hepmcsource.h
+// Description: sources of bytes for the buffered HepMC stream: plain files
+//              and pipes, and gzip, xz and zstd compressed files. The
+//              compressed formats are available if the converter is built
+//              with HAVE_ZLIB, HAVE_LZMA and HAVE_ZSTD, respectively.
+//
+//              An asyncSource runs another source on its own thread and
+//              hands over its output through a bounded queue of blocks, so
+//              that decompression overlaps with parsing. A zstd file that
+//              consists of several frames is decompressed frame by frame
+//              on a thread pool.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <cstdio>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "threadpool.h"
+
+class hepmcSource
+{
+ public:
+  ///
+  hepmcSource() : good_(true) {}
+
+  ///
+  virtual ~hepmcSource() {}
+
+  /// False if the source could not be opened or a read failed.
+  bool good() { return good_; }
+
+  /// Read at most size bytes. Return number of bytes read, 0 at end.
+  virtual size_t read(char* buffer, size_t size) = 0;
+
+ protected:
+  bool good_;
+};
+
+/** Plain file, named pipe or standard input ("-"). A read from a pipe
+    returns as soon as some bytes are available.
+*/
+class fileSource : public hepmcSource
+{
+ public:
+  fileSource(std::string filename);
+  virtual ~fileSource();
+  size_t read(char* buffer, size_t size);
+ private:
+  int fd_;
+};
+
+#ifdef HAVE_ZLIB
+/// gzip compressed file.
+class gzipSource : public hepmcSource
+{
+ public:
+  gzipSource(std::string filename);
+  virtual ~gzipSource();
+  size_t read(char* buffer, size_t size);
+ private:
+  void* file_;
+};
+#endif
+
+#ifdef HAVE_LZMA
+/// xz compressed file.
+class xzSource : public hepmcSource
+{
+ public:
+  xzSource(std::string filename);
+  virtual ~xzSource();
+  size_t read(char* buffer, size_t size);
+ private:
+  FILE* file_;
+  void* stream_;
+  std::vector<char> input_;
+  bool eof_;
+};
+#endif
+
+#ifdef HAVE_ZSTD
+/// zstd compressed file, decompressed as a stream.
+class zstdSource : public hepmcSource
+{
+ public:
+  zstdSource(std::string filename);
+  virtual ~zstdSource();
+  size_t read(char* buffer, size_t size);
+ private:
+  FILE* file_;
+  void* stream_;
+  std::vector<char> input_;
+  size_t pos_;
+  size_t size_;
+};
+
+/// zstd compressed file of several frames, decompressed in parallel.
+class zstdFrameSource : public hepmcSource
+{
+ public:
+  zstdFrameSource(std::string filename, int nthreads);
+  virtual ~zstdFrameSource();
+  size_t read(char* buffer, size_t size);
+
+  /// Return number of frames in file.
+  size_t frames() { return frame_.size(); }
+
+ private:
+  const char* data_;
+  size_t size_;
+  std::vector<std::pair<size_t, size_t> > frame_; // offset, size
+  size_t next_;
+
+  threadPool* pool_;
+  std::deque<std::future<std::vector<char>*> > busy_;
+  std::vector<char>* current_;
+  size_t pos_;
+
+  static std::vector<char>* decompress(const char* data, size_t size);
+};
+#endif
+
+/// Run a source on its own thread.
+class asyncSource : public hepmcSource
+{
+ public:
+  asyncSource(hepmcSource* source,
+              size_t blocksize=1 << 22, size_t nblocks=8);
+  virtual ~asyncSource();
+  size_t read(char* buffer, size_t size);
+
+ private:
+  struct block
+  {
+    std::vector<char> data;
+    size_t size;
+  };
+
+  hepmcSource* source_;
+  std::vector<block*> blocks_;
+  std::deque<block*> free_;
+  std::deque<block*> full_;
+  block* current_;
+  size_t pos_;
+  bool eof_;
+  bool done_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::thread thread_;
+
+  void run();
+};
+
+/** Compression format of file: "gzip", "xz", "zstd" or "" if none. Pipes
+    are taken to be uncompressed.
+*/
+std::string compression(std::string filename);
+
+/** Open a source for the given file, decompressing it if necessary.
+    Return 0 if the file is compressed in a format that is not available.
+*/
+hepmcSource* openSource(std::string filename, int nthreads=1);
+#endif
@@ -0,0 +1,46 @@
+#ifndef HEPMCSTREAM_H
+#define HEPMCSTREAM_H
+//----------------------------------------------------------------------------
+// File: hepmcstream.h
+// Description: buffered input stream of HepMC events. The source is read in
+//              large blocks, so this works for pipes and compressed files
+//              as well as for plain files.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include "hepmcinput.h"
+#include "hepmcsource.h"
+
+class hepmcStream : public hepmcInput
+{
+ public:
+  ///
+  hepmcStream(std::string filename, size_t bufsize=1 << 24);
+
+  /// Read from the given source, which is adopted.
+  hepmcStream(hepmcSource* source, std::string filename,
+              size_t bufsize=1 << 24);
+
+  ///
+  virtual ~hepmcStream();
+
+  /** Get byte range [begin, end) of next event. The range remains valid
+      until the next call to read(). Return false at end of file.
+  */
+  bool read(const char*& begin, const char*& end);
+
+  using hepmcInput::read;
+
+ private:
+  hepmcSource* source_;
+  bool   eof_;
+
+  std::vector<char> buffer_;
+  size_t start_;
+  size_t size_;
+
+  bool fill();
+  void init(std::string filename);
+};
+#endif
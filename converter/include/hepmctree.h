@@ -0,0 +1,158 @@
+#ifndef HEPMCTREE_H
+#define HEPMCTREE_H
+//----------------------------------------------------------------------------
+// File: hepmctree.h
+// Description: write the contents of a Bag to the Events tree using the
+//              same leaflist branches as bin/hepmc2root.py, that is,
+//              scalars for the Event_, Xsection_ and PDF_ variables and
+//              variable length arrays [Event_numberP] for the Particle_
+//              variables. The daughter and mother lists are variable length
+//              arrays [Event_numberD] and [Event_numberM].
+//
+//              The schema "full" (the default) stores the particle arrays
+//              with the types of the Bag. The compact schemas store the
+//              positions and momenta as Float_t ("compact") or as Float_t
+//              in memory, Float16_t on disk with a 14-bit mantissa
+//              ("compact16"), the barcodes as Int_t and the status codes as
+//              Short_t, all of which itreestream::select converts to the
+//              types of eventBuffer.h. If the schema includes "pidcode",
+//              e.g., "compact16,pidcode", Particle_pid is replaced by the
+//              Short_t Particle_pidcode, an index into the PDG ids of the
+//              tree Particle_pidtable. If it includes "vertex", the
+//              positions are not repeated for each particle: Particle_x,
+//              Particle_y, Particle_z and Particle_ctau are replaced by
+//              Particle_vertex, an index into the arrays [Event_numberVX]
+//              Vertex_barcode, Vertex_x, Vertex_y, Vertex_z and Vertex_ctau
+//              (see bag.h). If it includes "kinematics", the arrays
+//              Particle_pt, Particle_eta, Particle_phi and Particle_rapidity,
+//              computed by the converter, are stored after Particle_status,
+//              with the type of the momenta.
+//
+//              A checkpoint saves the tree header together with a resume
+//              point, kept in the UserInfo list of the tree, so that a job
+//              that is killed can be continued by another that reopens the
+//              file (resume = true) and appends to the entries saved.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <functional>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+#include "TFile.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "bag.h"
+#include "hepmcoutput.h"
+
+const std::string TREENAME("Events");
+
+class hepmcTree : public hepmcOutput
+{
+ public:
+  ///
+  hepmcTree(std::string filename, Bag& bag, std::string version,
+            std::string schema="full", std::string treename=TREENAME,
+            bool resume=false);
+
+  ///
+  virtual ~hepmcTree();
+
+  /// Fill tree with current contents of bag.
+  void fill();
+
+  /** Compress baskets on n threads. With ROOT implicit multithreading the
+      baskets of different branches are compressed concurrently, both when
+      they fill up and when a cluster of entries is flushed, so that
+      compression no longer runs serially after each fill.
+  */
+  void setThreads(int n);
+
+  /** Set ROOT compression settings: 100 * algorithm + level, e.g., 101
+      (zlib, level 1), 404 (lz4, level 4) or 505 (zstd, level 5).
+  */
+  void setCompression(int settings);
+
+  /** Flush baskets and save the tree header every n entries, so that the
+      entries written so far can be read while the conversion is running.
+      If n <= 0, use the ROOT defaults.
+  */
+  void setFlush(long long n);
+
+  /** Flush baskets and save the tree header with the given resume point.
+      From the first checkpoint on, ROOT no longer saves the header by
+      itself, so that the entries saved are always those of the last
+      checkpoint.
+  */
+  bool checkpoint(std::string point);
+
+  /// Return resume point of the last checkpoint of a resumed tree.
+  std::string resumePoint() { return point_; }
+
+  /// Write tree and close file.
+  void close();
+
+  /// Return number of entries written.
+  long long entries();
+
+  /// Return number of bytes written to the file so far.
+  long long bytes();
+
+  /// List branches.
+  void ls();
+
+ private:
+  TFile* file_;
+  TTree* tree_;
+  Bag*   bag_;
+  long long flush_;
+  long long bytes_; // bytes written, once the file is closed
+  bool resume_;
+  std::string point_;
+  std::vector<TBranch*> branch_;
+
+  struct column
+  {
+    TBranch* branch;
+    std::function<void*()> address;
+    void* current;
+    std::function<void()> convert;
+  };
+  std::vector<column> column_;
+
+  // buffers of the arrays converted to another type, and the PDG ids
+  // that correspond to the values of Particle_pidcode
+  std::list<std::vector<char> > buffer_;
+  std::map<int, int> pidcode_;
+  std::vector<int> pidtable_;
+
+  void add(std::string name, void* address, std::string type,
+           std::string count="");
+
+  void add(std::string name, void* address, char type,
+           std::string count="")
+  { add(name, address, std::string(1, type), count); }
+
+  /// Add an array, whose address is updated when the bag grows.
+  template <class T>
+  void add(std::string name, std::vector<T>& array, char type,
+           std::string count="Event_numberP");
+
+  /** Add an array of type T that is stored as type U, with leaf type
+      given as in a leaflist, e.g., "F" or "f[0,0,14]". The array is
+      converted at each fill.
+  */
+  template <class U, class T>
+  void add(std::string name, std::vector<T>& array, std::string type,
+           std::string count="Event_numberP");
+
+  /// Add Particle_pidcode.
+  void addPidcode();
+
+  /// Write the tree Particle_pidtable.
+  void writePidtable();
+
+  /// Return address of the count of an array.
+  int* counter(std::string count);
+};
+#endif
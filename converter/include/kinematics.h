@@ -0,0 +1,39 @@
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+//----------------------------------------------------------------------------
+// File: kinematics.h
+// Description: compute the derived kinematic variables of the particles of
+//              an event, Particle_pt, Particle_eta, Particle_phi and
+//              Particle_rapidity, from their momenta and energies.
+//              The variables are computed column by column over the
+//              particle arrays of the bag in loops without branches, which
+//              the compiler vectorizes; only the logarithms and arctangents
+//              are taken one value at a time, by the math library.
+//
+//                pt       = sqrt(px^2 + py^2)
+//                eta      = sign(pz) log((|p| + |pz|) / pt)
+//                phi      = atan2(py, px)
+//                rapidity = sign(pz) log((E + |pz|) / (E - |pz|)) / 2
+//
+//              The form of eta does not lose precision for particles close
+//              to the beam axis. The rapidity is computed from E and pz
+//              alone, so that it is exact also for off-shell particles,
+//              whose Particle_mass differs from sqrt(E^2 - p^2). As in
+//              TVector3::PseudoRapidity, a particle along the axis has
+//              eta = +-10e10 (0 if its momentum is zero), and likewise a
+//              particle with E <= |pz| has rapidity +-10e10 (0 if pz = 0).
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include "bag.h"
+
+/// Compute the derived kinematic variables of the particles in the bag.
+void computeKinematics(Bag& bag);
+
+/** Compute pt, eta, phi and rapidity of n particles with the given
+    momenta and energies.
+*/
+void computeKinematics(const double* px, const double* py, const double* pz,
+                       const double* energy,
+                       double* pt, double* eta, double* phi, double* rapidity,
+                       int n);
+#endif
@@ -0,0 +1,93 @@
+#ifndef PARTICLESELECTION_H
+#define PARTICLESELECTION_H
+//----------------------------------------------------------------------------
+// File: particleselection.h
+// Description: select the particles to be kept at conversion time. A
+//              selection is a list of criteria separated by blanks or
+//              semicolons, all of which a particle must pass,
+//
+//                status=1,21-29      status in list (ranges allowed)
+//                pid=11,-11          PDG id in list
+//                |pid|=11,13,15      absolute PDG id in list
+//                pt>0.5              transverse momentum cut (>, >=, <, <=)
+//
+//              The word "or" separates alternatives, any of which a
+//              particle may pass, e.g.,
+//
+//                status=21-29 or status=1 pt>0.5
+//
+//              keeps the hard process and the final-state particles with
+//              pT above 0.5 (in the units of the file).
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include <utility>
+#include <vector>
+#include "bag.h"
+
+class particleSelection
+{
+ public:
+  ///
+  particleSelection(std::string expression);
+
+  ///
+  virtual ~particleSelection();
+
+  /// True if the expression is valid.
+  bool good() { return good_; }
+
+  /// True if particle index of bag passes the selection.
+  bool operator()(const Bag& bag, int index) const
+  {
+    for(size_t a=0; a < alternative_.size(); a++)
+      {
+        const std::vector<criterion>& c = alternative_[a];
+        size_t k = 0;
+        while ( k < c.size() && pass(c[k], bag, index) ) k++;
+        if ( k == c.size() ) return true;
+      }
+    return false;
+  }
+
+ private:
+  enum {STATUS, PID, ABSPID, PT};
+  enum {LT, LE, GT, GE};
+
+  struct criterion
+  {
+    int variable;
+    std::vector<std::pair<int, int> > range; // STATUS, PID, ABSPID
+    int    op;                               // PT
+    double cut;                              // PT (squared)
+  };
+
+  bool good_;
+  std::vector<std::vector<criterion> > alternative_;
+
+  bool decode(std::string word, criterion& c);
+
+  static bool pass(const criterion& c, const Bag& bag, int index)
+  {
+    if ( c.variable == PT )
+      {
+        double px = bag.Particle_px[index];
+        double py = bag.Particle_py[index];
+        double pt2 = px * px + py * py;
+        switch ( c.op )
+          {
+          case LT: return pt2 <  c.cut;
+          case LE: return pt2 <= c.cut;
+          case GT: return pt2 >  c.cut;
+          default: return pt2 >= c.cut;
+          }
+      }
+    int x = c.variable == STATUS ? bag.Particle_status[index]
+      : bag.Particle_pid[index];
+    if ( c.variable == ABSPID && x < 0 ) x = -x;
+    for(size_t i=0; i < c.range.size(); i++)
+      if ( c.range[i].first <= x && x <= c.range[i].second ) return true;
+    return false;
+  }
+};
+#endif
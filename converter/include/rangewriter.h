@@ -0,0 +1,74 @@
+#ifndef RANGEWRITER_H
+#define RANGEWRITER_H
+//----------------------------------------------------------------------------
+// File: rangewriter.h
+// Description: write byte ranges, e.g., the records of selected events, to
+//              a file without copying them. The ranges are queued and
+//              adjacent ones merged; the queue is written with vectored
+//              writes (writev). Ranges that lie in the memory mapping of a
+//              source file are instead copied from file to file by the
+//              kernel (copy_file_range, on Linux), so that their bytes
+//              never pass through user space.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+class rangeWriter
+{
+ public:
+  ///
+  rangeWriter(std::string filename);
+
+  ///
+  virtual ~rangeWriter();
+
+  /// True if all is well.
+  bool good() { return good_; }
+
+  /** Copy the ranges that lie in [data, data + size), the mapping of the
+      file with descriptor fd, from that file. The descriptor remains
+      owned by the caller.
+  */
+  void setSource(int fd, const char* data, size_t size);
+
+  /** Queue range [begin, end), which must remain valid until the next
+      flush(). The queue is flushed when it is large.
+  */
+  void write(const char* begin, const char* end);
+
+  /// Write string, e.g., a header, right away.
+  void write(const std::string& s)
+  {
+    write(s.data(), s.data() + s.size());
+    flush();
+  }
+
+  /// Write queued ranges.
+  void flush();
+
+  /// Flush and close file.
+  void close();
+
+  /// Return number of bytes written.
+  size_t bytes() { return bytes_; }
+
+ private:
+  bool good_;
+  int  fd_;
+  int  source_;
+  const char* data_;
+  size_t size_;
+  size_t bytes_;
+  size_t queued_;
+  std::vector<std::pair<const char*, size_t> > range_;
+
+  bool inSource(const char* p, size_t n)
+  {
+    return source_ >= 0 && p >= data_ && p + n <= data_ + size_;
+  }
+  void writeRanges(size_t first, size_t last);
+  void copyRange(const char* p, size_t n);
+};
+#endif
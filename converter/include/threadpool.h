@@ -0,0 +1,57 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+//----------------------------------------------------------------------------
+// File: threadpool.h
+// Description: a fixed set of worker threads that execute tasks in the
+//              order they are submitted. Each submit() returns a future
+//              through which the caller waits for the result of the task.
+// Created: 16-Oct-2026 HBP
+//----------------------------------------------------------------------------
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class threadPool
+{
+ public:
+  ///
+  threadPool(int nthreads);
+
+  ///
+  virtual ~threadPool();
+
+  /// Return number of worker threads.
+  int size() { return (int)workers_.size(); }
+
+  /// Queue a task.
+  template <class F>
+  std::future<decltype(std::declval<F>()())> submit(F f)
+  {
+    typedef decltype(f()) R;
+    std::shared_ptr<std::packaged_task<R()> >
+      task(new std::packaged_task<R()>(f));
+    std::future<R> result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back([task]() { (*task)(); });
+    }
+    ready_.notify_one();
+    return result;
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()> > tasks_;
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  bool done_;
+
+  void run();
+};
+#endif
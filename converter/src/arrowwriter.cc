@@ -0,0 +1,548 @@
+// -----------------------------------------------------------------------------
+// File: arrowwriter.cc
+// Description: write a table to a file in the Arrow IPC file format
+//
+//              The file is laid out as
+//
+//                "ARROW1" <padding>
+//                schema message
+//                record batch message, body
+//                ...
+//                end-of-stream marker
+//                footer, footer size, "ARROW1"
+//
+//              Each message is a continuation marker (0xFFFFFFFF), the size
+//              of the metadata and the metadata, a flatbuffer of the
+//              Message table in Message.fbs of the Arrow format, followed
+//              by the body, that is, the buffers of a record batch. Values
+//              are written in the byte order of the host, which is taken to
+//              be little endian.
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include "arrowwriter.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  // constants of the Arrow format (Schema.fbs, Message.fbs)
+  const int16_t METADATA_V5   = 4;
+  const uint8_t HEADER_SCHEMA = 1;
+  const uint8_t HEADER_BATCH  = 3;
+  const uint8_t TYPE_INT      = 2;
+  const uint8_t TYPE_FLOAT    = 3;
+  const uint8_t TYPE_LIST     = 12;
+  const int16_t SINGLE        = 1;
+  const int16_t DOUBLE        = 2;
+
+  /** A flatbuffers object: a table, a vector of tables, a vector of
+      structs or a string. A field of a table holds either a scalar or the
+      offset of another object.
+  */
+  struct fbObject
+  {
+    enum kind {TABLE, TABLES, STRUCTS, STRING};
+
+    struct field
+    {
+      int id;
+      int size;
+      uint64_t value;
+      fbObject* object;
+    };
+
+    kind k;
+    vector<field> fields;
+    vector<fbObject*> objects;
+    string bytes;
+    uint32_t count;
+  };
+
+  /** Build a flatbuffer front to back. An object is written before the
+      objects it refers to, so that all offsets point forward, as they
+      must, and are filled in once the position of the target is known.
+  */
+  class fbBuilder
+  {
+  public:
+    fbObject* table() { return make(fbObject::TABLE); }
+
+    fbObject* tables() { return make(fbObject::TABLES); }
+
+    fbObject* structs(const void* data, size_t size, uint32_t count)
+    {
+      fbObject* o = make(fbObject::STRUCTS);
+      if ( size > 0 ) o->bytes = string((const char*)data, size);
+      o->count = count;
+      return o;
+    }
+
+    fbObject* str(string s)
+    {
+      fbObject* o = make(fbObject::STRING);
+      o->bytes = s;
+      o->count = s.size();
+      return o;
+    }
+
+    void scalar(fbObject* t, int id, int size, uint64_t value)
+    {
+      fbObject::field f = {id, size, value, 0};
+      t->fields.push_back(f);
+    }
+
+    void offset(fbObject* t, int id, fbObject* o)
+    {
+      fbObject::field f = {id, 4, 0, o};
+      t->fields.push_back(f);
+    }
+
+    /// Return flatbuffer with given root table, padded to 8 bytes.
+    vector<char> finish(fbObject* root)
+    {
+      buf_.clear();
+      uint32_t zero = 0;
+      put(&zero, 4);
+      patch(0, write(root));
+      align(8);
+      return buf_;
+    }
+
+  private:
+    vector<unique_ptr<fbObject> > pool_;
+    vector<char> buf_;
+
+    fbObject* make(fbObject::kind k)
+    {
+      pool_.push_back(unique_ptr<fbObject>(new fbObject()));
+      pool_.back()->k = k;
+      pool_.back()->count = 0;
+      return pool_.back().get();
+    }
+
+    void put(const void* p, size_t n)
+    {
+      buf_.insert(buf_.end(), (const char*)p, (const char*)p + n);
+    }
+
+    void align(size_t a)
+    {
+      while ( buf_.size() % a ) buf_.push_back(0);
+    }
+
+    void patch(size_t at, size_t target)
+    {
+      uint32_t u = target - at;
+      memcpy(&buf_[at], &u, 4);
+    }
+
+    /// Write object and return its position.
+    size_t write(fbObject* o)
+    {
+      size_t p = 0;
+      switch ( o->k )
+        {
+        case fbObject::TABLE:
+          {
+            // lay out the fields after the offset to the vtable, each
+            // aligned to its size
+            int nslot = 0;
+            for(size_t i=0; i < o->fields.size(); i++)
+              if ( o->fields[i].id + 1 > nslot ) nslot = o->fields[i].id + 1;
+            vector<uint16_t> vtable(2 + nslot, 0);
+            vector<size_t> at(o->fields.size());
+            size_t size = 4;
+            for(size_t i=0; i < o->fields.size(); i++)
+              {
+                size_t n = o->fields[i].size;
+                size = (size + n - 1) / n * n;
+                at[i] = size;
+                vtable[2 + o->fields[i].id] = size;
+                size += n;
+              }
+            vtable[0] = 2 * vtable.size();
+            vtable[1] = size;
+
+            align(2);
+            size_t v = buf_.size();
+            put(vtable.data(), 2 * vtable.size());
+
+            align(8);
+            p = buf_.size();
+            int32_t soffset = p - v;
+            buf_.resize(p + size, 0);
+            memcpy(&buf_[p], &soffset, 4);
+            for(size_t i=0; i < o->fields.size(); i++)
+              if ( o->fields[i].object == 0 )
+                memcpy(&buf_[p + at[i]], &o->fields[i].value,
+                       o->fields[i].size);
+            for(size_t i=0; i < o->fields.size(); i++)
+              if ( o->fields[i].object )
+                patch(p + at[i], write(o->fields[i].object));
+          }
+          break;
+
+        case fbObject::TABLES:
+          {
+            align(4);
+            p = buf_.size();
+            uint32_t n = o->objects.size();
+            put(&n, 4);
+            buf_.resize(p + 4 + 4 * n, 0);
+            for(size_t i=0; i < n; i++)
+              patch(p + 4 + 4 * i, write(o->objects[i]));
+          }
+          break;
+
+        case fbObject::STRUCTS:
+          // the structs are 8-byte aligned
+          while ( (buf_.size() + 4) % 8 ) buf_.push_back(0);
+          p = buf_.size();
+          put(&o->count, 4);
+          put(o->bytes.data(), o->bytes.size());
+          break;
+
+        case fbObject::STRING:
+          align(4);
+          p = buf_.size();
+          put(&o->count, 4);
+          put(o->bytes.data(), o->bytes.size());
+          buf_.push_back(0);
+          break;
+        }
+      return p;
+    }
+  };
+
+  /// Return Field table of a column.
+  fbObject* makeField(fbBuilder& b, string name, arrowWriter::type t)
+  {
+    fbObject* field = b.table();
+    fbObject* type  = b.table();
+    fbObject* children = b.tables();
+    b.offset(field, 0, b.str(name));
+    b.scalar(field, 1, 1, 0);        // not nullable
+    switch ( t )
+      {
+      case arrowWriter::INT8:
+      case arrowWriter::INT16:
+      case arrowWriter::INT32:
+      case arrowWriter::INT64:
+        {
+          int bits[] = {8, 16, 32, 64};
+          b.scalar(field, 2, 1, TYPE_INT);
+          b.scalar(type, 0, 4, bits[t - arrowWriter::INT8]);
+          b.scalar(type, 1, 1, 1);   // signed
+        }
+        break;
+      case arrowWriter::FLOAT32:
+      case arrowWriter::FLOAT64:
+        b.scalar(field, 2, 1, TYPE_FLOAT);
+        b.scalar(type, 0, 2, t == arrowWriter::FLOAT32 ? SINGLE : DOUBLE);
+        break;
+      case arrowWriter::LIST_INT32:
+        b.scalar(field, 2, 1, TYPE_LIST);
+        children->objects.push_back(makeField(b, "item", arrowWriter::INT32));
+        break;
+      }
+    b.offset(field, 3, type);
+    b.offset(field, 5, children);
+    return field;
+  }
+
+  /// Return Schema table of the columns.
+  fbObject* makeSchema(fbBuilder& b,
+                       const vector<string>& names,
+                       const vector<arrowWriter::type>& types,
+                       const vector<pair<string, string> >& metadata)
+  {
+    fbObject* schema = b.table();
+    fbObject* fields = b.tables();
+    for(size_t c=0; c < names.size(); c++)
+      fields->objects.push_back(makeField(b, names[c], types[c]));
+    b.offset(schema, 1, fields);
+
+    fbObject* keyvalues = b.tables();
+    for(size_t i=0; i < metadata.size(); i++)
+      {
+        fbObject* kv = b.table();
+        b.offset(kv, 0, b.str(metadata[i].first));
+        b.offset(kv, 1, b.str(metadata[i].second));
+        keyvalues->objects.push_back(kv);
+      }
+    b.offset(schema, 2, keyvalues);
+    return schema;
+  }
+
+  /// Return size in bytes of a value.
+  size_t width(arrowWriter::type t)
+  {
+    size_t w[] = {1, 2, 4, 8, 4, 8, 4};
+    return w[t];
+  }
+}
+// -----------------------------------------------------------------------------
+
+arrowWriter::arrowWriter(string filename)
+  : filename_(filename),
+    file_(fopen(filename.c_str(), "wb")),
+    good_(true),
+    started_(false),
+    position_(0),
+    col_(vector<col>()),
+    metadata_(vector<pair<string, string> >()),
+    block_(vector<block>())
+{
+  if ( file_ == 0 )
+    {
+      cerr << "** arrowWriter: can't open file " << filename << endl;
+      good_ = false;
+    }
+}
+
+arrowWriter::~arrowWriter()
+{
+  close();
+}
+
+void arrowWriter::metadata(string key, string value)
+{
+  metadata_.push_back(pair<string, string>(key, value));
+}
+
+int arrowWriter::column(string name, type t)
+{
+  if ( started_ )
+    {
+      cerr << "** arrowWriter: column " << name
+           << " added after first record batch" << endl;
+      good_ = false;
+    }
+  col c;
+  c.name = name;
+  c.t    = t;
+  c.rows = 0;
+  if ( t == LIST_INT32 ) c.offsets.push_back(0);
+  col_.push_back(c);
+  return col_.size() - 1;
+}
+
+void arrowWriter::append(int c, const void* values, size_t n)
+{
+  col& cl = col_[c];
+  const char* p = (const char*)values;
+  cl.values.insert(cl.values.end(), p, p + n * width(cl.t));
+  cl.rows += n;
+}
+
+void arrowWriter::repeat(int c, const void* value, size_t n)
+{
+  col& cl = col_[c];
+  size_t w = width(cl.t);
+  size_t at = cl.values.size();
+  cl.values.resize(at + n * w);
+  for(size_t i=0; i < n; i++, at += w) memcpy(&cl.values[at], value, w);
+  cl.rows += n;
+}
+
+void arrowWriter::append(int c, const int* offset, size_t n,
+                         const int* values, size_t nvalues)
+{
+  // the offsets of a batch are counted from its first value
+  col& cl = col_[c];
+  int32_t base = cl.offsets.back();
+  for(size_t i=1; i < n; i++) cl.offsets.push_back(base + offset[i]);
+  if ( n > 0 ) cl.offsets.push_back(base + (int32_t)nvalues);
+  const char* p = (const char*)values;
+  cl.values.insert(cl.values.end(), p, p + nvalues * sizeof(int32_t));
+  cl.rows += n;
+}
+
+size_t arrowWriter::rows()
+{
+  return col_.size() > 0 ? col_[0].rows : 0;
+}
+
+size_t arrowWriter::size()
+{
+  size_t n = 0;
+  for(size_t c=0; c < col_.size(); c++)
+    n += col_[c].values.size() + 4 * col_[c].offsets.size();
+  return n;
+}
+
+void arrowWriter::write(const void* data, size_t n)
+{
+  if ( ! good_ ) return;
+  if ( fwrite(data, 1, n, file_) != n )
+    {
+      cerr << "** arrowWriter: can't write to file " << filename_ << endl;
+      good_ = false;
+    }
+  position_ += n;
+}
+
+void arrowWriter::pad()
+{
+  static const char zero[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  if ( position_ % 8 ) write(zero, 8 - position_ % 8);
+}
+
+void arrowWriter::start()
+{
+  started_ = true;
+  write("ARROW1\0\0", 8);
+
+  vector<string> names;
+  vector<type> types;
+  for(size_t c=0; c < col_.size(); c++)
+    {
+      names.push_back(col_[c].name);
+      types.push_back(col_[c].t);
+    }
+  fbBuilder b;
+  fbObject* message = b.table();
+  b.scalar(message, 0, 2, METADATA_V5);
+  b.scalar(message, 1, 1, HEADER_SCHEMA);
+  b.offset(message, 2, makeSchema(b, names, types, metadata_));
+  b.scalar(message, 3, 8, 0);
+  vector<char> fb = b.finish(message);
+
+  int32_t prefix[2] = {-1, (int32_t)fb.size()};
+  write(prefix, 8);
+  write(fb.data(), fb.size());
+}
+
+void arrowWriter::flush()
+{
+  if ( ! good_ ) return;
+  if ( ! started_ ) start();
+  size_t n = rows();
+  if ( n == 0 ) return;
+
+  // list the buffers of the body: each column has a validity bitmap,
+  // which is empty as there are no null values, and its values; a list
+  // column has offsets and a child column of values
+  struct node { int64_t length; int64_t nulls; };
+  struct buffer { int64_t offset; int64_t length; };
+  vector<node> nodes;
+  vector<buffer> buffers;
+  vector<const void*> data;
+  int64_t body = 0;
+  for(size_t c=0; c < col_.size(); c++)
+    {
+      col& cl = col_[c];
+      if ( cl.rows != n )
+        {
+          cerr << "** arrowWriter: column " << cl.name << " has "
+               << cl.rows << " rows instead of " << n << endl;
+          good_ = false;
+          return;
+        }
+      node nd = {(int64_t)n, 0};
+      nodes.push_back(nd);
+      buffer validity = {body, 0};
+      buffers.push_back(validity);
+      data.push_back(0);
+      if ( cl.t == LIST_INT32 )
+        {
+          int64_t length = 4 * cl.offsets.size();
+          buffer offsets = {body, length};
+          buffers.push_back(offsets);
+          data.push_back(cl.offsets.data());
+          body += (length + 7) / 8 * 8;
+
+          node child = {(int64_t)(cl.values.size() / 4), 0};
+          nodes.push_back(child);
+          buffer cvalidity = {body, 0};
+          buffers.push_back(cvalidity);
+          data.push_back(0);
+        }
+      int64_t length = cl.values.size();
+      buffer values = {body, length};
+      buffers.push_back(values);
+      data.push_back(cl.values.data());
+      body += (length + 7) / 8 * 8;
+    }
+
+  fbBuilder b;
+  fbObject* batch = b.table();
+  b.scalar(batch, 0, 8, n);
+  b.offset(batch, 1, b.structs(nodes.data(), nodes.size() * sizeof(node),
+                               nodes.size()));
+  b.offset(batch, 2, b.structs(buffers.data(),
+                               buffers.size() * sizeof(buffer),
+                               buffers.size()));
+  fbObject* message = b.table();
+  b.scalar(message, 0, 2, METADATA_V5);
+  b.scalar(message, 1, 1, HEADER_BATCH);
+  b.offset(message, 2, batch);
+  b.scalar(message, 3, 8, body);
+  vector<char> fb = b.finish(message);
+
+  block bl = {position_, (int32_t)(8 + fb.size()), body};
+  block_.push_back(bl);
+  int32_t prefix[2] = {-1, (int32_t)fb.size()};
+  write(prefix, 8);
+  write(fb.data(), fb.size());
+  for(size_t i=0; i < buffers.size(); i++)
+    if ( buffers[i].length > 0 )
+      {
+        write(data[i], buffers[i].length);
+        pad();
+      }
+
+  for(size_t c=0; c < col_.size(); c++)
+    {
+      col_[c].rows = 0;
+      col_[c].values.clear();
+      if ( col_[c].t == LIST_INT32 ) col_[c].offsets.assign(1, 0);
+    }
+}
+
+void arrowWriter::close()
+{
+  if ( file_ == 0 ) return;
+  flush();
+
+  if ( good_ )
+    {
+      int32_t eos[2] = {-1, 0};
+      write(eos, 8);
+
+      // the footer repeats the schema and lists the record batches
+      vector<string> names;
+      vector<type> types;
+      for(size_t c=0; c < col_.size(); c++)
+        {
+          names.push_back(col_[c].name);
+          types.push_back(col_[c].t);
+        }
+      struct fbblock { int64_t offset; int32_t metadata; int32_t pad;
+        int64_t body; };
+      vector<fbblock> blocks;
+      for(size_t i=0; i < block_.size(); i++)
+        {
+          fbblock fb = {block_[i].offset, block_[i].metadata, 0,
+                        block_[i].body};
+          blocks.push_back(fb);
+        }
+
+      fbBuilder b;
+      fbObject* footer = b.table();
+      b.scalar(footer, 0, 2, METADATA_V5);
+      b.offset(footer, 1, makeSchema(b, names, types, metadata_));
+      b.offset(footer, 2, b.structs(0, 0, 0));
+      b.offset(footer, 3, b.structs(blocks.data(),
+                                    blocks.size() * sizeof(fbblock),
+                                    blocks.size()));
+      vector<char> fb = b.finish(footer);
+      write(fb.data(), fb.size());
+      int32_t size = fb.size();
+      write(&size, 4);
+      write("ARROW1", 6);
+    }
+  if ( fclose(file_) != 0 ) good_ = false;
+  file_ = 0;
+}
@@ -0,0 +1,68 @@
+// -----------------------------------------------------------------------------
+// File: barcodemap.cc
+// Description: open-addressing hash map from barcode to index
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include "barcodemap.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  // largest number of entries for which clear() makes room
+  const size_t MAXHINT = (size_t)1 << 24;
+}
+
+barcodeMap::barcodeMap()
+  : slot_(vector<slot>()),
+    mask_(0),
+    shift_(32),
+    count_(0),
+    generation_(1)
+{
+  resize(64);
+}
+
+barcodeMap::~barcodeMap() {}
+
+void barcodeMap::clear(size_t n)
+{
+  count_ = 0;
+  // n is only a hint; the table grows as entries are inserted
+  if ( n > MAXHINT ) n = MAXHINT;
+  if ( n > slot_.size() / 2 )
+    {
+      size_t m = slot_.size();
+      while ( m / 2 < n ) m *= 2;
+      resize(m);
+      return;
+    }
+
+  // a slot is in use only if it carries the current generation
+  if ( ++generation_ == 0 )
+    {
+      for(size_t i=0; i < slot_.size(); i++) slot_[i].generation = 0;
+      generation_ = 1;
+    }
+}
+
+void barcodeMap::resize(size_t n)
+{
+  slot empty = {0, 0, -1};
+  slot_.assign(n, empty);
+  mask_ = n - 1;
+  shift_ = 32;
+  for(size_t m=n; m > 1; m >>= 1) shift_--;
+  count_ = 0;
+  generation_ = 1;
+}
+
+void barcodeMap::grow()
+{
+  // rehash the current entries into a table twice the size
+  vector<slot> old;
+  old.swap(slot_);
+  uint32_t generation = generation_;
+  resize(2 * old.size());
+  for(size_t i=0; i < old.size(); i++)
+    if ( old[i].generation == generation )
+      insert(old[i].barcode, old[i].index);
+}
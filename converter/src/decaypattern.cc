@@ -0,0 +1,259 @@
+// -----------------------------------------------------------------------------
+// File: decaypattern.cc
+// Description: match events against decay patterns
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <charconv>
+#include <cstdlib>
+#include <iostream>
+#include "decaypattern.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  /// Split pattern into words, commas and parentheses.
+  vector<string> tokenize(const string& pattern)
+  {
+    vector<string> token;
+    string word;
+    for(size_t i=0; i <= pattern.size(); i++)
+      {
+        char c = i < pattern.size() ? pattern[i] : ' ';
+        if ( c == ' ' || c == '\t' || c == '\n' ||
+             c == ',' || c == '(' || c == ')' )
+          {
+            if ( word != "" ) token.push_back(word);
+            word = "";
+            if ( c == ',' || c == '(' || c == ')' )
+              token.push_back(string(1, c));
+          }
+        else
+          word += c;
+      }
+    return token;
+  }
+
+  /// Decode a PDG id, or |PDG id|. Return false if word is neither.
+  bool decode(string word, int& pid, bool& any)
+  {
+    any = word.size() > 2 && word[0] == '|' && word[word.size()-1] == '|';
+    if ( any ) word = word.substr(1, word.size()-2);
+    const char* end = word.c_str() + word.size();
+    from_chars_result r = from_chars(word.c_str(), end, pid);
+    return r.ec == errc() && r.ptr == end;
+  }
+}
+
+bool selfConjugate(int pid)
+{
+  if ( pid <= 0 ) return false;
+  switch ( pid )
+    {
+    case 21: case 22: case 23: case 25: case 32: case 33: case 35: case 36:
+    case 39: case 130: case 310:
+      return true;
+    default:
+      break;
+    }
+  // mesons made of a quark and its antiquark, e.g., 111, 221, 443
+  int nq1 = (pid / 1000) % 10;
+  int nq2 = (pid / 100) % 10;
+  int nq3 = (pid / 10) % 10;
+  return nq1 == 0 && nq2 > 0 && nq2 == nq3;
+}
+
+decayPattern::decayPattern(string pattern)
+  : good_(true),
+    node_(vector<node>()),
+    decay_(vector<vector<decay> >())
+{
+  vector<string> token = tokenize(pattern);
+  size_t i = 0;
+  while ( good_ && i < token.size() )
+    {
+      decay d;
+      d.parent = parse(token, i);
+      if ( d.parent < 0 ) break;
+      d.cc = i < token.size() && token[i] == "cc";
+      if ( d.cc ) i++;
+      if ( i < token.size() && token[i++] != "," )
+        {
+          cerr << "** decayPattern: expected , before " << token[i-1] << endl;
+          good_ = false;
+          break;
+        }
+
+      // group the decays by parent
+      const node& p = node_[d.parent];
+      size_t g = 0;
+      while ( g < decay_.size() &&
+              ! (node_[decay_[g][0].parent].pid == p.pid &&
+                 node_[decay_[g][0].parent].any == p.any) ) g++;
+      if ( g == decay_.size() ) decay_.push_back(vector<decay>());
+      decay_[g].push_back(d);
+    }
+  if ( good_ && decay_.empty() )
+    {
+      cerr << "** decayPattern: no decay in " << pattern << endl;
+      good_ = false;
+    }
+}
+
+decayPattern::~decayPattern() {}
+
+int decayPattern::parse(const vector<string>& token, size_t& i)
+{
+  // a decay is a parent followed by at least one daughter, each of which
+  // is a particle or a decay in parentheses
+  node n;
+  if ( i >= token.size() || ! decode(token[i], n.pid, n.any) )
+    {
+      cerr << "** decayPattern: expected a PDG id"
+           << (i < token.size() ? string(" at ") + token[i] : string(""))
+           << endl;
+      good_ = false;
+      return -1;
+    }
+  i++;
+  while ( i < token.size() && token[i] != "," && token[i] != ")" &&
+          token[i] != "cc" )
+    {
+      int d = -1;
+      if ( token[i] == "(" )
+        {
+          i++;
+          d = parse(token, i);
+          if ( d < 0 ) return -1;
+          if ( i >= token.size() || token[i] != ")" )
+            {
+              cerr << "** decayPattern: missing )" << endl;
+              good_ = false;
+              return -1;
+            }
+          i++;
+        }
+      else
+        {
+          node leaf;
+          if ( ! decode(token[i], leaf.pid, leaf.any) )
+            {
+              cerr << "** decayPattern: expected a PDG id at "
+                   << token[i] << endl;
+              good_ = false;
+              return -1;
+            }
+          i++;
+          d = node_.size();
+          node_.push_back(leaf);
+        }
+      n.daughter.push_back(d);
+    }
+  if ( n.daughter.empty() )
+    {
+      cerr << "** decayPattern: no daughters given for " << n.pid << endl;
+      good_ = false;
+      return -1;
+    }
+  node_.push_back(n);
+  return node_.size() - 1;
+}
+
+string decayPattern::str(int n) const
+{
+  const node& p = node_[n];
+  string s = p.any ? string("|") + to_string(p.pid) + "|" : to_string(p.pid);
+  for(size_t k=0; k < p.daughter.size(); k++)
+    {
+      const node& d = node_[p.daughter[k]];
+      if ( d.daughter.empty() )
+        s += string(" ") + str(p.daughter[k]);
+      else
+        s += string(" (") + str(p.daughter[k]) + ")";
+    }
+  return s;
+}
+
+string decayPattern::str() const
+{
+  string s;
+  for(size_t g=0; g < decay_.size(); g++)
+    for(size_t k=0; k < decay_[g].size(); k++)
+      {
+        if ( s != "" ) s += ", ";
+        s += str(decay_[g][k].parent);
+        if ( decay_[g][k].cc ) s += " cc";
+      }
+  return s;
+}
+
+bool decayPattern::operator()(const Bag& bag) const
+{
+  // each parent must decay in at least one of its ways
+  for(size_t g=0; g < decay_.size(); g++)
+    {
+      const vector<decay>& ways = decay_[g];
+      bool found = false;
+      for(int index=0; index < bag.Event_numberP && ! found; index++)
+        for(size_t k=0; k < ways.size() && ! found; k++)
+          found = match(bag, ways[k].parent, index, false) ||
+            (ways[k].cc && match(bag, ways[k].parent, index, true));
+      if ( ! found ) return false;
+    }
+  return true;
+}
+
+bool decayPattern::match(const Bag& bag, int n, int index,
+                         bool conjugate) const
+{
+  const node& p = node_[n];
+  int pid = conjugate && ! selfConjugate(abs(p.pid)) ? -p.pid : p.pid;
+  int x = bag.Particle_pid[index];
+  if ( p.any ? abs(x) != abs(pid) : x != pid ) return false;
+  if ( p.daughter.empty() ) return true;
+
+  index = lastCopy(bag, index);
+  int first = bag.Particle_doffset[index];
+  int last  = index + 1 < bag.Event_numberP ?
+    bag.Particle_doffset[index+1] : bag.Event_numberD;
+  if ( last - first < (int)p.daughter.size() ) return false;
+  vector<int> used;
+  used.reserve(p.daughter.size());
+  return assign(bag, p, 0, first, last, conjugate, used);
+}
+
+bool decayPattern::assign(const Bag& bag, const node& parent, size_t k,
+                          int first, int last, bool conjugate,
+                          vector<int>& used) const
+{
+  // match daughter k of the pattern to a particle not used by daughters
+  // 0,..,k-1, backtracking if the remaining ones then fail
+  if ( k == parent.daughter.size() ) return true;
+  for(int d=first; d < last; d++)
+    {
+      int index = bag.Daughter_index[d];
+      size_t u = 0;
+      while ( u < used.size() && used[u] != index ) u++;
+      if ( u < used.size() ) continue;
+      if ( ! match(bag, parent.daughter[k], index, conjugate) ) continue;
+      used.push_back(index);
+      if ( assign(bag, parent, k + 1, first, last, conjugate, used) )
+        return true;
+      used.pop_back();
+    }
+  return false;
+}
+
+int decayPattern::lastCopy(const Bag& bag, int index)
+{
+  int pid = bag.Particle_pid[index];
+  for(int step=0; step < bag.Event_numberP; step++)
+    {
+      int first = bag.Particle_doffset[index];
+      int last  = index + 1 < bag.Event_numberP ?
+        bag.Particle_doffset[index+1] : bag.Event_numberD;
+      int d = first;
+      while ( d < last && bag.Particle_pid[bag.Daughter_index[d]] != pid ) d++;
+      if ( d == last ) break;
+      index = bag.Daughter_index[d];
+    }
+  return index;
+}
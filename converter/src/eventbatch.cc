@@ -0,0 +1,178 @@
+// -----------------------------------------------------------------------------
+// File: eventbatch.cc
+// Description: a batch of events stored column-wise
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstddef>
+#include <cstring>
+#include "eventbatch.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  const size_t SCALARS = offsetof(Bag, Particle_x);
+
+  template <class T>
+  inline void put(vector<T>& column, const T* source, int n)
+  {
+    column.insert(column.end(), source, source + n);
+  }
+
+  template <class T>
+  inline void take(vector<T>& column, size_t offset, T* target, int n)
+  {
+    memcpy(target, column.data() + offset, n * sizeof(T));
+  }
+}
+
+eventBatch::eventBatch()
+  : kinematics_(false)
+{}
+
+eventBatch::~eventBatch() {}
+
+void eventBatch::clear()
+{
+  scalars_.clear();
+  offset_.clear();
+
+  Particle_x.clear();
+  Particle_y.clear();
+  Particle_z.clear();
+  Particle_ctau.clear();
+
+  Particle_barcode.clear();
+  Particle_pid.clear();
+  Particle_px.clear();
+  Particle_py.clear();
+  Particle_pz.clear();
+  Particle_energy.clear();
+  Particle_mass.clear();
+  Particle_status.clear();
+  Particle_d1.clear();
+  Particle_d2.clear();
+  Particle_m1.clear();
+  Particle_m2.clear();
+  Particle_doffset.clear();
+  Particle_moffset.clear();
+  Particle_vertex.clear();
+
+  Particle_pt.clear();
+  Particle_eta.clear();
+  Particle_phi.clear();
+  Particle_rapidity.clear();
+
+  doffset_.clear();
+  Daughter_index.clear();
+  moffset_.clear();
+  Mother_index.clear();
+
+  voffset_.clear();
+  Vertex_barcode.clear();
+  Vertex_x.clear();
+  Vertex_y.clear();
+  Vertex_z.clear();
+  Vertex_ctau.clear();
+}
+
+void eventBatch::append(Bag& bag)
+{
+  const char* s = (const char*)&bag;
+  scalars_.insert(scalars_.end(), s, s + SCALARS);
+  offset_.push_back(Particle_x.size());
+
+  int n = bag.Event_numberP;
+  put(Particle_x,       bag.Particle_x.data(),      n);
+  put(Particle_y,       bag.Particle_y.data(),      n);
+  put(Particle_z,       bag.Particle_z.data(),      n);
+  put(Particle_ctau,    bag.Particle_ctau.data(),   n);
+
+  put(Particle_barcode, bag.Particle_barcode.data(), n);
+  put(Particle_pid,     bag.Particle_pid.data(),    n);
+  put(Particle_px,      bag.Particle_px.data(),     n);
+  put(Particle_py,      bag.Particle_py.data(),     n);
+  put(Particle_pz,      bag.Particle_pz.data(),     n);
+  put(Particle_energy,  bag.Particle_energy.data(), n);
+  put(Particle_mass,    bag.Particle_mass.data(),   n);
+  put(Particle_status,  bag.Particle_status.data(), n);
+  put(Particle_d1,      bag.Particle_d1.data(),     n);
+  put(Particle_d2,      bag.Particle_d2.data(),     n);
+  put(Particle_m1,      bag.Particle_m1.data(),     n);
+  put(Particle_m2,      bag.Particle_m2.data(),     n);
+  put(Particle_doffset, bag.Particle_doffset.data(), n);
+  put(Particle_moffset, bag.Particle_moffset.data(), n);
+  put(Particle_vertex,  bag.Particle_vertex.data(),  n);
+
+  if ( kinematics_ )
+    {
+      put(Particle_pt,       bag.Particle_pt.data(),       n);
+      put(Particle_eta,      bag.Particle_eta.data(),      n);
+      put(Particle_phi,      bag.Particle_phi.data(),      n);
+      put(Particle_rapidity, bag.Particle_rapidity.data(), n);
+    }
+
+  doffset_.push_back(Daughter_index.size());
+  put(Daughter_index, bag.Daughter_index.data(), bag.Event_numberD);
+  moffset_.push_back(Mother_index.size());
+  put(Mother_index,   bag.Mother_index.data(),   bag.Event_numberM);
+
+  int nv = bag.Event_numberVX;
+  voffset_.push_back(Vertex_x.size());
+  put(Vertex_barcode, bag.Vertex_barcode.data(), nv);
+  put(Vertex_x,       bag.Vertex_x.data(),       nv);
+  put(Vertex_y,       bag.Vertex_y.data(),       nv);
+  put(Vertex_z,       bag.Vertex_z.data(),       nv);
+  put(Vertex_ctau,    bag.Vertex_ctau.data(),    nv);
+}
+
+void eventBatch::get(size_t i, Bag& bag)
+{
+  memcpy((char*)&bag, scalars_.data() + i * SCALARS, SCALARS);
+
+  size_t k = offset_[i];
+  int n = bag.Event_numberP;
+  bag.reserve(n);
+  take(Particle_x,       k, bag.Particle_x.data(),      n);
+  take(Particle_y,       k, bag.Particle_y.data(),      n);
+  take(Particle_z,       k, bag.Particle_z.data(),      n);
+  take(Particle_ctau,    k, bag.Particle_ctau.data(),   n);
+
+  take(Particle_barcode, k, bag.Particle_barcode.data(), n);
+  take(Particle_pid,     k, bag.Particle_pid.data(),    n);
+  take(Particle_px,      k, bag.Particle_px.data(),     n);
+  take(Particle_py,      k, bag.Particle_py.data(),     n);
+  take(Particle_pz,      k, bag.Particle_pz.data(),     n);
+  take(Particle_energy,  k, bag.Particle_energy.data(), n);
+  take(Particle_mass,    k, bag.Particle_mass.data(),   n);
+  take(Particle_status,  k, bag.Particle_status.data(), n);
+  take(Particle_d1,      k, bag.Particle_d1.data(),     n);
+  take(Particle_d2,      k, bag.Particle_d2.data(),     n);
+  take(Particle_m1,      k, bag.Particle_m1.data(),     n);
+  take(Particle_m2,      k, bag.Particle_m2.data(),     n);
+  take(Particle_doffset, k, bag.Particle_doffset.data(), n);
+  take(Particle_moffset, k, bag.Particle_moffset.data(), n);
+  take(Particle_vertex,  k, bag.Particle_vertex.data(),  n);
+
+  if ( kinematics_ )
+    {
+      take(Particle_pt,       k, bag.Particle_pt.data(),       n);
+      take(Particle_eta,      k, bag.Particle_eta.data(),      n);
+      take(Particle_phi,      k, bag.Particle_phi.data(),      n);
+      take(Particle_rapidity, k, bag.Particle_rapidity.data(), n);
+    }
+
+  bag.reserveDaughters(bag.Event_numberD);
+  take(Daughter_index, doffset_[i], bag.Daughter_index.data(),
+       bag.Event_numberD);
+  bag.reserveMothers(bag.Event_numberM);
+  take(Mother_index,   moffset_[i], bag.Mother_index.data(),
+       bag.Event_numberM);
+
+  int nv = bag.Event_numberVX;
+  k = voffset_[i];
+  bag.reserveVertices(nv);
+  take(Vertex_barcode, k, bag.Vertex_barcode.data(), nv);
+  take(Vertex_x,       k, bag.Vertex_x.data(),       nv);
+  take(Vertex_y,       k, bag.Vertex_y.data(),       nv);
+  take(Vertex_z,       k, bag.Vertex_z.data(),       nv);
+  take(Vertex_ctau,    k, bag.Vertex_ctau.data(),    nv);
+}
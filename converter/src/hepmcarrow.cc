@@ -0,0 +1,211 @@
+// -----------------------------------------------------------------------------
+// File: hepmcarrow.cc
+// Description: write the contents of a Bag to Arrow IPC (Feather) files
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstdio>
+#include <ctime>
+#include "hepmcarrow.h"
+#include "hepmcmonitor.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  /// Arrow type of the C++ type T.
+  template <class T> arrowWriter::type arrowType();
+  template <> arrowWriter::type arrowType<int>()
+  { return arrowWriter::INT32; }
+  template <> arrowWriter::type arrowType<double>()
+  { return arrowWriter::FLOAT64; }
+
+  // write a batch early if its particles take more than this many bytes
+  const size_t MAXSIZE = 64 << 20;
+}
+
+hepmcArrow::hepmcArrow(string filename, Bag& bag, string version,
+                       bool kinematics)
+  : hepmcOutput(),
+    bag_(&bag),
+    events_(filename),
+    particles_(particleFile(filename)),
+    batch_(1000),
+    maxsize_(MAXSIZE),
+    entries_(0),
+    scalar_(vector<scalar>()),
+    array_(vector<array>()),
+    key_(-1),
+    daughters_(-1),
+    mothers_(-1),
+    ls_(vector<string>())
+{
+  if ( ! events_.good() || ! particles_.good() )
+    {
+      good_ = false;
+      return;
+    }
+
+  time_t t = time(0);
+  string now(ctime(&t));
+  now = now.substr(0, now.size()-1); // skip "\n"
+  events_.metadata("created", now);
+  events_.metadata("HepMC", version);
+  particles_.metadata("created", now);
+  particles_.metadata("HepMC", version);
+
+  add("Event_number",     &bag.Event_number);
+  add("Event_numberMP",   &bag.Event_numberMP);
+  add("Event_scale",      &bag.Event_scale);
+  add("Event_alphaQCD",   &bag.Event_alphaQCD);
+  add("Event_alphaQED",   &bag.Event_alphaQED);
+  add("Event_barcodeSPV", &bag.Event_barcodeSPV);
+  add("Event_numberV",    &bag.Event_numberV);
+  add("Event_barcodeBP1", &bag.Event_barcodeBP1);
+  add("Event_barcodeBP2", &bag.Event_barcodeBP2);
+  add("Event_numberP",    &bag.Event_numberP);
+
+  add("Xsection_value",   &bag.Xsection_value);
+  add("Xsection_error",   &bag.Xsection_error);
+
+  add("PDF_parton1",      &bag.PDF_parton1);
+  add("PDF_parton2",      &bag.PDF_parton2);
+  add("PDF_x1",           &bag.PDF_x1);
+  add("PDF_x2",           &bag.PDF_x2);
+  add("PDF_Q2",           &bag.PDF_Q2);
+  add("PDF_x1f",          &bag.PDF_x1f);
+  add("PDF_x2f",          &bag.PDF_x2f);
+  add("PDF_id1",          &bag.PDF_id1);
+  add("PDF_id2",          &bag.PDF_id2);
+
+  // the event number of each particle relates the two tables
+  key_ = particles_.column("Event_number", arrowWriter::INT32);
+  ls_.push_back("particles\tEvent_number\tint32");
+
+  add("Particle_x",       bag.Particle_x);
+  add("Particle_y",       bag.Particle_y);
+  add("Particle_z",       bag.Particle_z);
+  add("Particle_ctau",    bag.Particle_ctau);
+
+  add("Particle_barcode", bag.Particle_barcode);
+  add("Particle_pid",     bag.Particle_pid);
+  add("Particle_px",      bag.Particle_px);
+  add("Particle_py",      bag.Particle_py);
+  add("Particle_pz",      bag.Particle_pz);
+  add("Particle_energy",  bag.Particle_energy);
+  add("Particle_mass",    bag.Particle_mass);
+  add("Particle_status",  bag.Particle_status);
+  if ( kinematics )
+    {
+      add("Particle_pt",       bag.Particle_pt);
+      add("Particle_eta",      bag.Particle_eta);
+      add("Particle_phi",      bag.Particle_phi);
+      add("Particle_rapidity", bag.Particle_rapidity);
+    }
+  add("Particle_d1",      bag.Particle_d1);
+  add("Particle_d2",      bag.Particle_d2);
+
+  add("Particle_m1",      bag.Particle_m1);
+  add("Particle_m2",      bag.Particle_m2);
+
+  // the offsets of a list column take the place of Particle_doffset and
+  // Particle_moffset
+  daughters_ = particles_.column("Particle_daughters",
+                                 arrowWriter::LIST_INT32);
+  ls_.push_back("particles\tParticle_daughters\tlist<int32>");
+  mothers_   = particles_.column("Particle_mothers",
+                                 arrowWriter::LIST_INT32);
+  ls_.push_back("particles\tParticle_mothers\tlist<int32>");
+}
+
+hepmcArrow::~hepmcArrow()
+{
+  close();
+}
+
+string hepmcArrow::particleFile(string filename)
+{
+  string ext(".arrow");
+  if ( filename.size() > ext.size() &&
+       filename.substr(filename.size()-ext.size()) == ext )
+    filename = filename.substr(0, filename.size()-ext.size());
+  return filename + string(".particles") + ext;
+}
+
+template <class T>
+void hepmcArrow::add(string name, T* address)
+{
+  arrowWriter::type t = arrowType<T>();
+  scalar s = {events_.column(name, t), address};
+  scalar_.push_back(s);
+  ls_.push_back(string("events\t") + name + string("\t")
+                + string(t == arrowWriter::INT32 ? "int32" : "double"));
+}
+
+template <class T>
+void hepmcArrow::add(string name, vector<T>& array)
+{
+  arrowWriter::type t = arrowType<T>();
+  hepmcArrow::array a = {particles_.column(name, t),
+                         [&array]() { return (const void*)array.data(); }};
+  array_.push_back(a);
+  ls_.push_back(string("particles\t") + name + string("\t")
+                + string(t == arrowWriter::INT32 ? "int32" : "double"));
+}
+
+void hepmcArrow::setFlush(long long n)
+{
+  if ( n > 0 ) batch_ = n;
+}
+
+void hepmcArrow::fill()
+{
+  if ( ! good_ ) return;
+  Bag& bag = *bag_;
+  for(size_t c=0; c < scalar_.size(); c++)
+    events_.append(scalar_[c].column, scalar_[c].address, 1);
+
+  size_t n = bag.Event_numberP;
+  particles_.repeat(key_, &bag.Event_number, n);
+  for(size_t c=0; c < array_.size(); c++)
+    particles_.append(array_[c].column, array_[c].address(), n);
+  particles_.append(daughters_, bag.Particle_doffset.data(), n,
+                    bag.Daughter_index.data(), bag.Event_numberD);
+  particles_.append(mothers_, bag.Particle_moffset.data(), n,
+                    bag.Mother_index.data(), bag.Event_numberM);
+  entries_++;
+
+  if ( (long long)events_.rows() >= batch_ || particles_.size() > maxsize_ )
+    flush();
+}
+
+void hepmcArrow::flush()
+{
+  double t = seconds();
+  events_.flush();
+  particles_.flush();
+  write_ += seconds() - t;
+  if ( ! events_.good() || ! particles_.good() ) good_ = false;
+}
+
+void hepmcArrow::close()
+{
+  double t = seconds();
+  events_.close();
+  particles_.close();
+  write_ += seconds() - t;
+  if ( ! events_.good() || ! particles_.good() ) good_ = false;
+}
+
+long long hepmcArrow::entries()
+{
+  return entries_;
+}
+
+long long hepmcArrow::bytes()
+{
+  return events_.bytes() + particles_.bytes();
+}
+
+void hepmcArrow::ls()
+{
+  for(size_t ii=0; ii < ls_.size(); ii++)
+    printf("%4d\t%s\n", (int)ii+1, ls_[ii].c_str());
+}
@@ -0,0 +1,222 @@
+// -----------------------------------------------------------------------------
+// File: hepmccolumns.cc
+// Description: read the events of a HepMC file a chunk at a time into
+//              typed columns
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include "hepmccolumns.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  template <class T> char typeCode();
+  template <> char typeCode<int>() { return 'i'; }
+  template <> char typeCode<double>() { return 'd'; }
+}
+
+hepmcColumns::hepmcColumns(string filename, int nthreads, bool kinematics)
+  : input_(openHepMC(filename, nthreads)),
+    bag_(),
+    convert_(0),
+    column_(vector<column>())
+{
+  rows_[EVENTS] = rows_[PARTICLES] = 0;
+  if ( ! input_->good() ) return;
+  convert_ = new hepmcConverter(*input_, bag_, nthreads);
+  convert_->setKinematics(kinematics);
+
+  Bag& bag = bag_;
+  add("Event_number",     &bag.Event_number);
+  add("Event_numberMP",   &bag.Event_numberMP);
+  add("Event_scale",      &bag.Event_scale);
+  add("Event_alphaQCD",   &bag.Event_alphaQCD);
+  add("Event_alphaQED",   &bag.Event_alphaQED);
+  add("Event_processID",  &bag.Event_processID);
+  add("Event_barcodeSPV", &bag.Event_barcodeSPV);
+  add("Event_numberV",    &bag.Event_numberV);
+  add("Event_barcodeBP1", &bag.Event_barcodeBP1);
+  add("Event_barcodeBP2", &bag.Event_barcodeBP2);
+  add("Event_numberP",    &bag.Event_numberP);
+  add("Xsection_value",   &bag.Xsection_value);
+  add("Xsection_error",   &bag.Xsection_error);
+  add("PDF_parton1",      &bag.PDF_parton1);
+  add("PDF_parton2",      &bag.PDF_parton2);
+  add("PDF_x1",           &bag.PDF_x1);
+  add("PDF_x2",           &bag.PDF_x2);
+  add("PDF_Q2",           &bag.PDF_Q2);
+  add("PDF_x1f",          &bag.PDF_x1f);
+  add("PDF_x2f",          &bag.PDF_x2f);
+  add("PDF_id1",          &bag.PDF_id1);
+  add("PDF_id2",          &bag.PDF_id2);
+
+  key();
+  add<double>("Particle_x",    bag.Particle_x);
+  add<double>("Particle_y",    bag.Particle_y);
+  add<double>("Particle_z",    bag.Particle_z);
+  add<double>("Particle_ctau", bag.Particle_ctau);
+  add<int>("Particle_barcode", bag.Particle_barcode);
+  add<int>("Particle_pid",     bag.Particle_pid);
+  add<double>("Particle_px",   bag.Particle_px);
+  add<double>("Particle_py",   bag.Particle_py);
+  add<double>("Particle_pz",   bag.Particle_pz);
+  add<double>("Particle_energy", bag.Particle_energy);
+  add<double>("Particle_mass", bag.Particle_mass);
+  add<int>("Particle_status",  bag.Particle_status);
+  if ( kinematics )
+    {
+      add<double>("Particle_pt",       bag.Particle_pt);
+      add<double>("Particle_eta",      bag.Particle_eta);
+      add<double>("Particle_phi",      bag.Particle_phi);
+      add<double>("Particle_rapidity", bag.Particle_rapidity);
+    }
+  add<int>("Particle_d1",      bag.Particle_d1);
+  add<int>("Particle_d2",      bag.Particle_d2);
+  add<int>("Particle_m1",      bag.Particle_m1);
+  add<int>("Particle_m2",      bag.Particle_m2);
+}
+
+hepmcColumns::~hepmcColumns()
+{
+  if ( convert_ ) delete convert_;
+  delete input_;
+}
+
+bool hepmcColumns::good()
+{
+  return input_->good() && convert_ != 0 && convert_->good();
+}
+
+template <class T>
+void hepmcColumns::add(string name, T* address)
+{
+  column c;
+  c.name  = name;
+  c.type  = typeCode<T>();
+  c.table = EVENTS;
+  c.append = [address](vector<char>& values)
+    {
+      const char* p = (const char*)address;
+      values.insert(values.end(), p, p + sizeof(T));
+    };
+  column_.push_back(c);
+}
+
+template <class U, class T>
+void hepmcColumns::add(string name, vector<T>& array)
+{
+  column c;
+  c.name  = name;
+  c.type  = typeCode<U>();
+  c.table = PARTICLES;
+  int* count = &bag_.Event_numberP;
+  c.append = [&array, count](vector<char>& values)
+    {
+      // the barcodes, stored as doubles in the Bag, become integers
+      size_t n = *count;
+      size_t at = values.size();
+      values.resize(at + n * sizeof(U));
+      U* v = (U*)&values[at];
+      for(size_t i=0; i < n; i++) v[i] = (U)array[i];
+    };
+  column_.push_back(c);
+}
+
+void hepmcColumns::key()
+{
+  column c;
+  c.name  = "Event_number";
+  c.type  = 'i';
+  c.table = PARTICLES;
+  Bag* bag = &bag_;
+  c.append = [bag](vector<char>& values)
+    {
+      size_t n = bag->Event_numberP;
+      size_t at = values.size();
+      values.resize(at + n * sizeof(int));
+      int* v = (int*)&values[at];
+      for(size_t i=0; i < n; i++) v[i] = bag->Event_number;
+    };
+  column_.push_back(c);
+}
+
+long hepmcColumns::read(long n)
+{
+  rows_[EVENTS] = rows_[PARTICLES] = 0;
+  for(size_t c=0; c < column_.size(); c++) column_[c].values.clear();
+  if ( convert_ == 0 ) return 0;
+
+  long k = 0;
+  while ( k < n && convert_->next() )
+    {
+      for(size_t c=0; c < column_.size(); c++)
+        column_[c].append(column_[c].values);
+      rows_[EVENTS]++;
+      rows_[PARTICLES] += bag_.Event_numberP;
+      k++;
+    }
+  return k;
+}
+// -----------------------------------------------------------------------------
+// C interface
+// -----------------------------------------------------------------------------
+void* hepmc_open(const char* filename, int nthreads, int kinematics)
+{
+  hepmcColumns* columns = new hepmcColumns(filename, nthreads,
+                                           kinematics != 0);
+  if ( columns->good() ) return columns;
+  delete columns;
+  return 0;
+}
+
+void hepmc_close(void* columns)
+{
+  delete (hepmcColumns*)columns;
+}
+
+const char* hepmc_version(void* columns)
+{
+  static string version;
+  version = ((hepmcColumns*)columns)->version();
+  return version.c_str();
+}
+
+long hepmc_read(void* columns, long n)
+{
+  hepmcColumns* c = (hepmcColumns*)columns;
+  long k = c->read(n);
+  return c->good() ? k : -1;
+}
+
+int hepmc_columns(void* columns)
+{
+  return ((hepmcColumns*)columns)->size();
+}
+
+const char* hepmc_name(void* columns, int c)
+{
+  static string name;
+  name = ((hepmcColumns*)columns)->name(c);
+  return name.c_str();
+}
+
+char hepmc_type(void* columns, int c)
+{
+  return ((hepmcColumns*)columns)->type(c);
+}
+
+int hepmc_table(void* columns, int c)
+{
+  return ((hepmcColumns*)columns)->table(c);
+}
+
+long hepmc_rows(void* columns, int table)
+{
+  return ((hepmcColumns*)columns)->rows(table);
+}
+
+void hepmc_copy(void* columns, int c, void* buffer)
+{
+  hepmcColumns* h = (hepmcColumns*)columns;
+  size_t width = h->type(c) == 'i' ? sizeof(int) : sizeof(double);
+  memcpy(buffer, h->data(c), h->rows(h->table(c)) * width);
+}
@@ -0,0 +1,224 @@
+// -----------------------------------------------------------------------------
+// File: hepmcconverter.cc
+// Description: deliver the events of a HepMC input in their original order
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include "hepmcconverter.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+hepmcConverter::hepmcConverter(hepmcInput& input, Bag& bag,
+                               int nthreads, size_t chunksize)
+  : input_(&input),
+    bag_(&bag),
+    good_(true),
+    events_(0),
+    scanned_(0),
+    times_(stageTimes()),
+    pattern_(0),
+    begin_(0),
+    end_(0),
+    position_(input.position()),
+    pool_(0),
+    chunksize_(chunksize),
+    free_(vector<chunk*>()),
+    busy_(deque<pair<chunk*, future<bool> > >()),
+    current_(0),
+    entry_(0),
+    eof_(false),
+    failed_(false)
+{
+  if ( nthreads > 1 )
+    {
+      pool_ = new threadPool(nthreads);
+
+      // keep two chunks per thread in flight so that the workers do not
+      // wait while the oldest chunk is being consumed
+      for(int i=0; i < 2 * nthreads; i++) free_.push_back(new chunk());
+    }
+
+  parse_.setFormat(input.format());
+  for(size_t i=0; i < free_.size(); i++) free_[i]->parse.setFormat(input.format());
+}
+
+hepmcConverter::~hepmcConverter()
+{
+  // the pool finishes all queued tasks before its threads exit
+  if ( pool_ ) delete pool_;
+  while ( ! busy_.empty() )
+    {
+      delete busy_.front().first;
+      busy_.pop_front();
+    }
+  for(size_t i=0; i < free_.size(); i++) delete free_[i];
+  if ( current_ ) delete current_;
+}
+
+void hepmcConverter::setLimit(int n)
+{
+  parse_.setLimit(n);
+  for(size_t i=0; i < free_.size(); i++) free_[i]->parse.setLimit(n);
+}
+
+void hepmcConverter::setSelection(const particleSelection* select)
+{
+  parse_.setSelection(select);
+  for(size_t i=0; i < free_.size(); i++) free_[i]->parse.setSelection(select);
+}
+
+void hepmcConverter::setKinematics(bool on)
+{
+  parse_.setKinematics(on);
+  for(size_t i=0; i < free_.size(); i++)
+    {
+      free_[i]->parse.setKinematics(on);
+      free_[i]->batch.setKinematics(on);
+    }
+}
+
+void hepmcConverter::setPattern(const decayPattern* pattern)
+{
+  pattern_ = pattern;
+  for(size_t i=0; i < free_.size(); i++) free_[i]->pattern = pattern;
+}
+
+void hepmcConverter::range(const char*& begin, const char*& end)
+{
+  if ( pool_ == 0 )
+    {
+      begin = begin_;
+      end   = end_;
+      return;
+    }
+  begin = current_->range[entry_-1].first;
+  end   = current_->range[entry_-1].second;
+}
+
+stageTimes hepmcConverter::times()
+{
+  // the parsers of the chunks are added as the chunks are consumed
+  stageTimes t = times_;
+  t.add(parse_.times());
+  return t;
+}
+
+size_t hepmcConverter::position()
+{
+  if ( pool_ == 0 || current_ == 0 || entry_ == 0 ) return position_;
+
+  // the chunk ends at a known offset
+  const char* end = current_->range[entry_-1].second;
+  return current_->position - (current_->end - end);
+}
+
+bool hepmcConverter::parseChunk(chunk* c)
+{
+  c->batch.clear();
+  c->range.clear();
+  c->scanned = 0;
+  c->append = 0;
+  const char* p = findEvent(c->begin, c->end);
+  while ( p < c->end )
+    {
+      const char* q = (const char*)memchr(p, '\n', c->end - p);
+      q = q ? findEvent(q + 1, c->end) : c->end;
+      if ( ! c->parse(p, q, *c->bag) ) return false;
+      c->scanned++;
+      if ( c->pattern == 0 || (*c->pattern)(*c->bag) )
+        {
+          double t = seconds();
+          c->batch.append(*c->bag);
+          c->append += seconds() - t;
+          c->range.push_back(make_pair(p, q));
+        }
+      p = q;
+    }
+  return true;
+}
+
+bool hepmcConverter::next()
+{
+  if ( ! good_ ) return false;
+
+  if ( pool_ == 0 )
+    {
+      do
+        {
+          double t = seconds();
+          bool more = input_->read(begin_, end_);
+          times_.read += seconds() - t;
+          if ( ! more )
+            {
+              good_ = input_->good();
+              return false;
+            }
+          if ( ! parse_(begin_, end_, *bag_) )
+            {
+              good_ = false;
+              return false;
+            }
+          scanned_++;
+          position_ = input_->position();
+        }
+      while ( pattern_ != 0 && ! (*pattern_)(*bag_) );
+      events_++;
+      return true;
+    }
+
+  while ( current_ == 0 || entry_ >= current_->batch.size() )
+    {
+      if ( current_ )
+        {
+          // a chunk that failed delivers the events before the faulty one
+          if ( ! current_->ok )
+            {
+              good_ = false;
+              return false;
+            }
+          free_.push_back(current_);
+          current_ = 0;
+        }
+
+      // keep the pool busy
+      while ( ! eof_ && ! free_.empty() )
+        {
+          chunk* c = free_.back();
+          double t = seconds();
+          bool more = input_->read(c->begin, c->end, chunksize_, c->buffer);
+          times_.read += seconds() - t;
+          if ( ! more )
+            {
+              eof_ = true;
+              if ( ! input_->good() ) failed_ = true;
+              break;
+            }
+          c->position = input_->position();
+          free_.pop_back();
+          busy_.push_back(make_pair(c, pool_->submit([c]()
+                                                     { return parseChunk(c); })));
+        }
+      if ( busy_.empty() )
+        {
+          good_ = ! failed_;
+          return false;
+        }
+
+      double t = seconds();
+      current_ = busy_.front().first;
+      current_->ok = busy_.front().second.get();
+      busy_.pop_front();
+      times_.wait += seconds() - t;
+      scanned_ += current_->scanned;
+      times_.batch += current_->append;
+      times_.add(current_->parse.times());
+      current_->parse.clearTimes();
+      entry_ = 0;
+    }
+
+  double t = seconds();
+  current_->batch.get(entry_++, *bag_);
+  times_.batch += seconds() - t;
+  events_++;
+  return true;
+}
@@ -0,0 +1,270 @@
+// -----------------------------------------------------------------------------
+// File: hepmcindex.cc
+// Description: persistent byte-offset index of the events in a HepMC file
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sys/stat.h>
+#include "hepmcparser.h"
+#include "hepmcindex.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  const char MAGIC[8] = {'H', 'E', 'P', 'M', 'C', 'I', 'X', '1'};
+
+  struct indexHeader
+  {
+    char     magic[8];
+    uint64_t filesize;
+    int64_t  mtime;
+    int64_t  mtimensec;
+    uint64_t count;
+    uint64_t end;
+  };
+
+  bool fileInfo(string filename, indexHeader& h)
+  {
+    struct stat info;
+    if ( stat(filename.c_str(), &info) != 0 ) return false;
+    h.filesize  = info.st_size;
+#ifdef __APPLE__
+    h.mtime     = info.st_mtimespec.tv_sec;
+    h.mtimensec = info.st_mtimespec.tv_nsec;
+#else
+    h.mtime     = info.st_mtim.tv_sec;
+    h.mtimensec = info.st_mtim.tv_nsec;
+#endif
+    return true;
+  }
+}
+
+string indexName(string filename)
+{
+  return filename + string(".idx");
+}
+
+hepmcIndex::hepmcIndex()
+  : entry_(vector<indexEntry>()),
+    end_(0)
+{}
+
+hepmcIndex::~hepmcIndex() {}
+
+void hepmcIndex::build(hepmcMap& input)
+{
+  entry_.clear();
+
+  const char* b = input.data();
+  const char* e = b + input.size();
+  const char* p = findEvent(b + input.first(), e);
+  while ( p < e )
+    {
+      indexEntry entry;
+      memset(&entry, 0, sizeof(entry));
+      entry.offset = p - b;
+
+      // HepMC2: E number n-mpi scale alphaQCD alphaQED process-id
+      //         signal-vertex n-vertices ...
+      // HepMC3: E number n-vertices n-particles
+      const char* q = getField(p + 1, e, entry.number);
+      if ( input.format() == 2 )
+        for(int i=0; i < 6; i++) q = skipField(q, e);
+      getField(q, e, entry.numberV);
+
+      q = (const char*)memchr(p, '\n', e - p);
+      q = q ? findEvent(q + 1, e) : e;
+      if ( q == e ) q = findTrailer(p, e);
+
+      // count particle lines: like E, an upper case P appears only as a key
+      for(const char* r = p; (r = (const char*)memchr(r, 'P', q - r)) != 0; r++)
+        if ( r[-1] == '\n' ) entry.numberP++;
+
+      entry_.push_back(entry);
+      end_ = q - b;
+      p = findEvent(q, e);
+    }
+}
+
+bool hepmcIndex::load(string indexfile, string hepmcfile)
+{
+  indexHeader current;
+  if ( ! fileInfo(hepmcfile, current) ) return false;
+
+  FILE* f = fopen(indexfile.c_str(), "rb");
+  if ( f == 0 ) return false;
+
+  // the entries must fill the rest of the index file exactly, so that a
+  // truncated or corrupt file is rebuilt rather than trusted
+  struct stat info;
+  indexHeader h;
+  bool ok = fstat(fileno(f), &info) == 0
+    && (uint64_t)info.st_size >= sizeof(h)
+    && fread(&h, sizeof(h), 1, f) == 1
+    && memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0
+    && h.filesize  == current.filesize
+    && h.mtime     == current.mtime
+    && h.mtimensec == current.mtimensec
+    && h.end       <= h.filesize
+    && h.count == (info.st_size - sizeof(h)) / sizeof(indexEntry)
+    && (info.st_size - sizeof(h)) % sizeof(indexEntry) == 0;
+  if ( ok )
+    {
+      entry_.resize(h.count);
+      ok = fread(entry_.data(), sizeof(indexEntry), h.count, f) == h.count;
+      end_ = h.end;
+    }
+  fclose(f);
+  if ( ! ok ) entry_.clear();
+  return ok;
+}
+
+bool hepmcIndex::save(string indexfile, string hepmcfile)
+{
+  indexHeader h;
+  memset(&h, 0, sizeof(h));
+  if ( ! fileInfo(hepmcfile, h) ) return false;
+  memcpy(h.magic, MAGIC, sizeof(MAGIC));
+  h.count = entry_.size();
+  h.end   = end_;
+
+  FILE* f = fopen(indexfile.c_str(), "wb");
+  if ( f == 0 ) return false;
+  bool ok = fwrite(&h, sizeof(h), 1, f) == 1
+    && fwrite(entry_.data(), sizeof(indexEntry), h.count, f) == h.count;
+  ok = (fclose(f) == 0) && ok;
+  return ok;
+}
+
+size_t hepmcIndex::find(int number)
+{
+  if ( entry_.empty() ) return 0;
+
+  // events are usually numbered consecutively, so try that first
+  long long guess = (long long)number - entry_[0].number;
+  if ( guess >= 0 && guess < (long long)entry_.size()
+       && entry_[guess].number == number ) return guess;
+
+  for(size_t i=0; i < entry_.size(); i++)
+    if ( entry_[i].number == number ) return i;
+  return entry_.size();
+}
+
+hepmcIndex* openIndex(hepmcMap& input, string filename)
+{
+  hepmcIndex* index = new hepmcIndex();
+  string indexfile = indexName(filename);
+  if ( index->load(indexfile, filename) ) return index;
+
+  cout << "building index " << indexfile << endl;
+  index->build(input);
+  if ( ! index->save(indexfile, filename) )
+    cerr << "** hepmcIndex: can't write index file " << indexfile << endl;
+  return index;
+}
+
+vector<size_t> selectEvents(size_t size, long long first, long long count,
+                            long long sample, unsigned int seed)
+{
+  vector<size_t> events;
+  if ( first < 0 ) first = 0;
+  if ( first >= (long long)size ) return events;
+  long long last = size;
+  if ( count >= 0 && first + count < last ) last = first + count;
+
+  if ( sample <= 0 || sample >= last - first )
+    {
+      for(long long i=first; i < last; i++) events.push_back(i);
+      return events;
+    }
+
+  // selection sampling (Knuth, Algorithm S): each event is kept with
+  // probability (still needed)/(still available), which yields a sorted
+  // sample without storing the population
+  mt19937_64 engine(seed);
+  uniform_real_distribution<double> uniform(0, 1);
+  long long needed = sample;
+  for(long long i=first; i < last && needed > 0; i++)
+    if ( (last - i) * uniform(engine) < needed )
+      {
+        events.push_back(i);
+        needed--;
+      }
+  return events;
+}
+
+hepmcIndexedInput::hepmcIndexedInput(hepmcMap& input, hepmcIndex& index,
+                                     vector<size_t>& events)
+  : hepmcInput(),
+    input_(&input),
+    index_(&index),
+    events_(events),
+    next_(0)
+{
+  good_    = input.good();
+  version_ = input.version();
+  header_  = input.header();
+  format_  = input.format();
+
+  // the trailer follows the last event of the file, whichever events are
+  // delivered
+  if ( index.size() > 0 )
+    {
+      const char* e = input.data() + input.size();
+      trailer_ = string(findTrailer(input.data() + index.end(index.size()-1),
+                                    e), e);
+    }
+}
+
+hepmcIndexedInput::~hepmcIndexedInput() {}
+
+bool hepmcIndexedInput::read(const char*& begin, const char*& end)
+{
+  if ( ! good_ || next_ >= events_.size() ) return false;
+
+  size_t i = events_[next_++];
+  begin = input_->data() + (*index_)[i].offset;
+  end   = input_->data() + index_->end(i);
+  return true;
+}
+
+bool hepmcIndexedInput::read(const char*& begin, const char*& end,
+                             size_t nbytes, vector<char>& buffer)
+{
+  if ( ! good_ || next_ >= events_.size() ) return false;
+
+  // find events to be delivered
+  size_t first = next_;
+  size_t bytes = 0;
+  bool contiguous = true;
+  while ( next_ < events_.size() && bytes < nbytes )
+    {
+      size_t i = events_[next_];
+      if ( next_ > first &&
+           (*index_)[i].offset != index_->end(events_[next_-1]) )
+        contiguous = false;
+      bytes += index_->end(i) - (*index_)[i].offset;
+      next_++;
+    }
+
+  const char* data = input_->data();
+  if ( contiguous )
+    {
+      begin = data + (*index_)[events_[first]].offset;
+      end   = data + index_->end(events_[next_-1]);
+      return true;
+    }
+
+  buffer.clear();
+  for(size_t k=first; k < next_; k++)
+    {
+      size_t i = events_[k];
+      buffer.insert(buffer.end(),
+                    data + (*index_)[i].offset, data + index_->end(i));
+    }
+  begin = buffer.data();
+  end   = begin + buffer.size();
+  return true;
+}
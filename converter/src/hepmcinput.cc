@@ -0,0 +1,97 @@
+// -----------------------------------------------------------------------------
+// File: hepmcinput.cc
+// Description: model an input of HepMC events
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include <sstream>
+#include <sys/stat.h>
+#include "hepmcinput.h"
+#include "hepmcstream.h"
+#include "hepmcmap.h"
+#include "hepmcsource.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+const char* findEvent(const char* p, const char* end)
+{
+  // An upper case E appears only as the key of an event line: numbers are
+  // written with a lower case exponent, so this is a fast scan.
+  if ( p < end && p[0] == 'E' )
+    {
+      if ( p + 1 < end && p[1] == ' ' ) return p;
+      p++;
+    }
+  while ( p < end )
+    {
+      const char* q = (const char*)memchr(p, 'E', end - p);
+      if ( q == 0 ) return end;
+      if ( q[-1] == '\n' && q + 1 < end && q[1] == ' ' ) return q;
+      p = q + 1;
+    }
+  return end;
+}
+
+const char* findTrailer(const char* p, const char* end)
+{
+  static const char key[] = "\nHepMC::";
+  const char* q = (const char*)memmem(p, end - p, key, sizeof(key)-1);
+  return q ? q + 1 : end;
+}
+
+hepmcInput::hepmcInput()
+  : good_(true),
+    version_(""),
+    header_(""),
+    trailer_(""),
+    format_(2),
+    position_(0)
+{}
+
+hepmcInput::~hepmcInput() {}
+
+bool hepmcInput::decodeHeader(const char* begin, const char* end)
+{
+  // get version number of HepMC
+  header_ = string(begin, end);
+  istringstream inp(header_);
+  string key;
+  inp >> key >> version_;
+
+  // HepMC3 files may also be written in the HepMC2 format, so the format
+  // of the records is given by the start of the listing, not the version
+  format_ = header_.find("HepMC::Asciiv3-START_EVENT_LISTING") != string::npos
+    ? 3 : 2;
+  return key == "HepMC::Version";
+}
+
+bool hepmcInput::read(const char*& begin, const char*& end, size_t nbytes,
+                      vector<char>& buffer)
+{
+  buffer.clear();
+  const char* b = 0;
+  const char* e = 0;
+  while ( buffer.size() < nbytes && read(b, e) )
+    buffer.insert(buffer.end(), b, e);
+  begin = buffer.data();
+  end   = begin + buffer.size();
+  return buffer.size() > 0;
+}
+
+bool hepmcInput::seek(size_t offset)
+{
+  const char* b = 0;
+  const char* e = 0;
+  while ( position_ < offset && read(b, e) ) {}
+  return position_ == offset;
+}
+
+hepmcInput* openHepMC(string filename, int nthreads)
+{
+  struct stat info;
+  if ( stat(filename.c_str(), &info) == 0 && S_ISREG(info.st_mode)
+       && compression(filename) == "" )
+    return new hepmcMap(filename);
+  else
+    return new hepmcStream(openSource(filename, nthreads), filename);
+}
@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------------
+// File: hepmcmap.cc
+// Description: memory mapped input of HepMC events
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hepmcmap.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+hepmcMap::hepmcMap(string filename)
+  : hepmcInput(),
+    data_(0),
+    size_(0),
+    first_(0)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat info;
+  if ( fd < 0 || fstat(fd, &info) != 0 )
+    {
+      cerr << "** hepmcMap: can't open file " << filename << endl;
+      if ( fd >= 0 ) close(fd);
+      good_ = false;
+      return;
+    }
+
+  size_ = info.st_size;
+  if ( size_ > 0 )
+    {
+      void* addr = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( addr == MAP_FAILED )
+        {
+          cerr << "** hepmcMap: can't map file " << filename << endl;
+          close(fd);
+          size_ = 0;
+          good_ = false;
+          return;
+        }
+      data_ = (const char*)addr;
+      madvise(addr, size_, MADV_SEQUENTIAL);
+    }
+  // the mapping stays valid after the file is closed
+  close(fd);
+
+  const char* p = findEvent(data_, data_ + size_);
+  if ( ! decodeHeader(data_, p) )
+    {
+      cerr << "** hepmcMap: format problem in file " << filename << endl;
+      good_ = false;
+      return;
+    }
+  first_ = position_ = p - data_;
+}
+
+hepmcMap::~hepmcMap()
+{
+  if ( data_ ) munmap((void*)data_, size_);
+}
+
+bool hepmcMap::read(const char*& begin, const char*& end)
+{
+  if ( ! good_ ) return false;
+
+  const char* e = data_ + size_;
+  const char* p = findEvent(data_ + position_, e);
+  if ( p >= e )
+    {
+      position_ = size_;
+      return false;
+    }
+  const char* q = (const char*)memchr(p, '\n', e - p);
+  q = q ? findEvent(q + 1, e) : e;
+  if ( q == e )
+    {
+      q = findTrailer(p, e);
+      trailer_ = string(q, e);
+    }
+
+  begin = p;
+  end   = q;
+  position_ = q - data_;
+  return true;
+}
+
+bool hepmcMap::seek(size_t offset)
+{
+  if ( ! good_ || offset < first_ || offset > size_ ) return false;
+
+  // the offset must be at the start of an event or of the trailer
+  const char* p = data_ + offset;
+  const char* e = data_ + size_;
+  if ( p < e && findEvent(p, e) != p && findTrailer(p - 1, e) != p )
+    return false;
+  position_ = offset;
+  return true;
+}
+
+bool hepmcMap::read(const char*& begin, const char*& end, size_t nbytes,
+                    vector<char>& buffer)
+{
+  if ( ! good_ ) return false;
+
+  const char* e = data_ + size_;
+  const char* p = findEvent(data_ + position_, e);
+  if ( p >= e )
+    {
+      position_ = size_;
+      return false;
+    }
+
+  // jump ahead, then move to the start of the next event
+  const char* q = p + nbytes < e ? p + nbytes : e;
+  if ( q < e )
+    {
+      q = (const char*)memchr(q, '\n', e - q);
+      q = q ? findEvent(q + 1, e) : e;
+    }
+  if ( q == e )
+    {
+      q = findTrailer(p, e);
+      trailer_ = string(q, e);
+    }
+
+  begin = p;
+  end   = q;
+  position_ = q - data_;
+  return true;
+}
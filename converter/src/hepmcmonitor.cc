@@ -0,0 +1,181 @@
+// -----------------------------------------------------------------------------
+// File: hepmcmonitor.cc
+// Description: timers and counters of the stages of a conversion
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+#include "hepmcmonitor.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  /// Quote string for JSON.
+  string quote(const string& s)
+  {
+    string q("\"");
+    for(size_t i=0; i < s.size(); i++)
+      {
+        char c = s[i];
+        if ( c == '"' || c == '\\' )
+          q += string("\\") + c;
+        else if ( (unsigned char)c < 0x20 )
+          {
+            char code[8];
+            snprintf(code, sizeof(code), "\\u%04x", (unsigned char)c);
+            q += code;
+          }
+        else
+          q += c;
+      }
+    return q + string("\"");
+  }
+
+  /// Return x/t, or 0 if no time has passed.
+  double rate(double x, double t)
+  {
+    return t > 0 ? x / t : 0;
+  }
+
+  const double MB = 1024 * 1024;
+}
+
+long long peakRSS()
+{
+  struct rusage usage;
+  if ( getrusage(RUSAGE_SELF, &usage) != 0 ) return 0;
+#ifdef __APPLE__
+  return usage.ru_maxrss;        // bytes
+#else
+  return usage.ru_maxrss * 1024; // kilobytes
+#endif
+}
+
+hepmcMonitor::hepmcMonitor(string input, string output, int nthreads,
+                           string report, double interval)
+  : good_(true),
+    input_(input),
+    output_(output),
+    nthreads_(nthreads),
+    report_(report),
+    interval_(interval),
+    start_(seconds()),
+    elapsed_(0),
+    written_(start_),
+    events_(0),
+    particles_(0),
+    bytesin_(0),
+    bytesout_(0),
+    times_(stageTimes()),
+    ok_(true)
+{}
+
+hepmcMonitor::~hepmcMonitor() {}
+
+void hepmcMonitor::record(const stageTimes& times, long long bytesin,
+                          long long bytesout)
+{
+  times_    = times;
+  bytesin_  = bytesin;
+  bytesout_ = bytesout;
+  elapsed_  = seconds() - start_;
+}
+
+void hepmcMonitor::update(const stageTimes& times, long long bytesin,
+                          long long bytesout)
+{
+  record(times, bytesin, bytesout);
+  printf("%10lld events %10.1f events/s %12.0f particles/s %8.1f MB/s "
+         "%8.1f MB RSS\n",
+         events_, rate(events_, elapsed_), rate(particles_, elapsed_),
+         rate(bytesin_ / MB, elapsed_), peakRSS() / MB);
+  fflush(stdout);
+
+  if ( report_ != "" && start_ + elapsed_ - written_ >= interval_ )
+    {
+      write(false);
+      written_ = start_ + elapsed_;
+    }
+}
+
+void hepmcMonitor::finish(const stageTimes& times, long long bytesin,
+                          long long bytesout, bool ok)
+{
+  record(times, bytesin, bytesout);
+  ok_ = ok;
+  const stageTimes& t = times_;
+  printf("\nSummary\n"
+         "    events:        %10lld\n"
+         "    particles:     %10lld\n"
+         "    input (MB):    %10.1f\n"
+         "    output (MB):   %10.1f\n"
+         "    elapsed (s):   %10.2f\n"
+         "    events/s:      %10.1f\n"
+         "    particles/s:   %10.0f\n"
+         "    input MB/s:    %10.1f\n"
+         "    peak RSS (MB): %10.1f\n"
+         "    time (s) in read %.2f, parse %.2f, select %.2f, link %.2f,\n"
+         "                kinematics %.2f, batch %.2f, wait %.2f, fill %.2f,\n"
+         "                write %.2f\n\n",
+         events_, particles_, bytesin_ / MB, bytesout_ / MB, elapsed_,
+         rate(events_, elapsed_), rate(particles_, elapsed_),
+         rate(bytesin_ / MB, elapsed_), peakRSS() / MB,
+         t.read, t.parse, t.select, t.link, t.kinematics, t.batch, t.wait,
+         t.fill, t.write);
+  if ( report_ != "" ) write(true);
+}
+
+string hepmcMonitor::json(bool final)
+{
+  const stageTimes& t = times_;
+  ostringstream out;
+  out << "{\n"
+      << "  \"input\": "                << quote(input_) << ",\n"
+      << "  \"output\": "               << quote(output_) << ",\n"
+      << "  \"threads\": "              << nthreads_ << ",\n"
+      << "  \"final\": "                << (final ? "true" : "false") << ",\n"
+      << "  \"ok\": "                   << (ok_ ? "true" : "false") << ",\n"
+      << "  \"events\": "               << events_ << ",\n"
+      << "  \"particles\": "            << particles_ << ",\n"
+      << "  \"bytes_in\": "             << bytesin_ << ",\n"
+      << "  \"bytes_out\": "            << bytesout_ << ",\n"
+      << "  \"elapsed_seconds\": "      << elapsed_ << ",\n"
+      << "  \"events_per_second\": "    << rate(events_, elapsed_) << ",\n"
+      << "  \"particles_per_second\": " << rate(particles_, elapsed_) << ",\n"
+      << "  \"input_mb_per_second\": "  << rate(bytesin_ / MB, elapsed_)
+      << ",\n"
+      << "  \"peak_rss_bytes\": "       << peakRSS() << ",\n"
+      << "  \"stage_seconds\": {\n"
+      << "    \"read\": "   << t.read   << ",\n"
+      << "    \"parse\": "  << t.parse  << ",\n"
+      << "    \"select\": " << t.select << ",\n"
+      << "    \"link\": "   << t.link   << ",\n"
+      << "    \"kinematics\": " << t.kinematics << ",\n"
+      << "    \"batch\": "  << t.batch  << ",\n"
+      << "    \"wait\": "   << t.wait   << ",\n"
+      << "    \"fill\": "   << t.fill   << ",\n"
+      << "    \"write\": "  << t.write  << "\n"
+      << "  }\n"
+      << "}\n";
+  return out.str();
+}
+
+void hepmcMonitor::write(bool final)
+{
+  // write a new file and rename it, so that a reader never sees a
+  // partial report
+  string tmpname = report_ + string(".tmp");
+  string report = json(final);
+  FILE* file = fopen(tmpname.c_str(), "w");
+  bool ok = file != 0 &&
+    fwrite(report.data(), 1, report.size(), file) == report.size();
+  if ( file != 0 && fclose(file) != 0 ) ok = false;
+  if ( ok && rename(tmpname.c_str(), report_.c_str()) != 0 ) ok = false;
+  if ( ! ok )
+    {
+      if ( good_ )
+        cerr << "** hepmcMonitor: can't write report " << report_ << endl;
+      good_ = false;
+    }
+}
@@ -0,0 +1,278 @@
+// -----------------------------------------------------------------------------
+// File: hepmcntuple.cc
+// Description: write the contents of a Bag to the Events RNTuple
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include "hepmcmonitor.h"
+#include "hepmcntuple.h"
+#ifdef HAVE_RNTUPLE
+#include "TROOT.h"
+#endif
+using namespace std;
+// -----------------------------------------------------------------------------
+#ifdef HAVE_RNTUPLE
+namespace {
+  /// Copy n values of type T from src to every stride-th byte of dst.
+  template <class T>
+  void scatter(char* dst, size_t stride, const void* src, int n)
+  {
+    const T* s = (const T*)src;
+    for(int i=0; i < n; i++, dst += stride) memcpy(dst, &s[i], sizeof(T));
+  }
+}
+
+hepmcNtuple::hepmcNtuple(string filename, Bag& bag, string version,
+                         bool kinematics, string ntuplename)
+  : hepmcOutput(),
+    filename_(filename),
+    ntuplename_(ntuplename),
+    compression_(-1),
+    flush_(0),
+    entries_(0),
+    model_(ROOT::RNTupleModel::CreateBare()),
+    writer_(),
+    entry_(),
+    scalar_(vector<scalar>()),
+    collection_(vector<collection>()),
+    ls_(vector<string>())
+{
+  // the order of fields is that of the branches of the Events tree
+  add("Event_number",     &bag.Event_number);
+  add("Event_numberMP",   &bag.Event_numberMP);
+  add("Event_scale",      &bag.Event_scale);
+  add("Event_alphaQCD",   &bag.Event_alphaQCD);
+  add("Event_alphaQED",   &bag.Event_alphaQED);
+  add("Event_barcodeSPV", &bag.Event_barcodeSPV);
+  add("Event_numberV",    &bag.Event_numberV);
+  add("Event_barcodeBP1", &bag.Event_barcodeBP1);
+  add("Event_barcodeBP2", &bag.Event_barcodeBP2);
+  add("Event_numberP",    &bag.Event_numberP);
+
+  add("Xsection_value",   &bag.Xsection_value);
+  add("Xsection_error",   &bag.Xsection_error);
+
+  add("PDF_parton1",      &bag.PDF_parton1);
+  add("PDF_parton2",      &bag.PDF_parton2);
+  add("PDF_x1",           &bag.PDF_x1);
+  add("PDF_x2",           &bag.PDF_x2);
+  add("PDF_Q2",           &bag.PDF_Q2);
+  add("PDF_x1f",          &bag.PDF_x1f);
+  add("PDF_x2f",          &bag.PDF_x2f);
+  add("PDF_id1",          &bag.PDF_id1);
+  add("PDF_id2",          &bag.PDF_id2);
+
+  begin("Particle", &bag.Event_numberP);
+  add("Particle_x",       bag.Particle_x);
+  add("Particle_y",       bag.Particle_y);
+  add("Particle_z",       bag.Particle_z);
+  add("Particle_ctau",    bag.Particle_ctau);
+
+  add("Particle_barcode", bag.Particle_barcode);
+  add("Particle_pid",     bag.Particle_pid);
+  add("Particle_px",      bag.Particle_px);
+  add("Particle_py",      bag.Particle_py);
+  add("Particle_pz",      bag.Particle_pz);
+  add("Particle_energy",  bag.Particle_energy);
+  add("Particle_mass",    bag.Particle_mass);
+  add("Particle_status",  bag.Particle_status);
+  if ( kinematics )
+    {
+      add("Particle_pt",       bag.Particle_pt);
+      add("Particle_eta",      bag.Particle_eta);
+      add("Particle_phi",      bag.Particle_phi);
+      add("Particle_rapidity", bag.Particle_rapidity);
+    }
+  add("Particle_d1",      bag.Particle_d1);
+  add("Particle_d2",      bag.Particle_d2);
+
+  add("Particle_m1",      bag.Particle_m1);
+  add("Particle_m2",      bag.Particle_m2);
+  add("Particle_doffset", bag.Particle_doffset);
+  add("Particle_moffset", bag.Particle_moffset);
+  end();
+
+  add("Event_numberD",    &bag.Event_numberD);
+  begin("Daughter", &bag.Event_numberD);
+  add("Daughter_index",   bag.Daughter_index);
+  end();
+
+  add("Event_numberM",    &bag.Event_numberM);
+  begin("Mother", &bag.Event_numberM);
+  add("Mother_index",     bag.Mother_index);
+  end();
+}
+
+hepmcNtuple::~hepmcNtuple()
+{
+  close();
+}
+
+template <class T>
+void hepmcNtuple::add(string name, T* address)
+{
+  unique_ptr<ROOT::RField<T> > field(new ROOT::RField<T>(name));
+  ls_.push_back(name + string("\t") + field->GetTypeName());
+  model_->AddField(std::move(field));
+  scalar s = {name, address};
+  scalar_.push_back(s);
+}
+
+void hepmcNtuple::begin(string name, int* count)
+{
+  collection c;
+  c.name  = name;
+  c.count = count;
+  c.size  = 0;
+  collection_.push_back(std::move(c));
+}
+
+template <class T>
+void hepmcNtuple::add(string name, vector<T>& array)
+{
+  collection& c = collection_.back();
+  unique_ptr<ROOT::RField<T> > field(new ROOT::RField<T>(name));
+  ls_.push_back(c.name + string(".") + name + string("\t")
+                + field->GetTypeName());
+  c.fields.push_back(std::move(field));
+  member m = {[&array]() { return (const void*)array.data(); },
+              scatter<T>, 0};
+  c.members.push_back(m);
+}
+
+void hepmcNtuple::end()
+{
+  // the record field decides the offsets of its members
+  collection& c = collection_.back();
+  unique_ptr<ROOT::RRecordField>
+    record(new ROOT::RRecordField("_0", std::move(c.fields)));
+  const vector<size_t>& offsets = record->GetOffsets();
+  for(size_t m=0; m < c.members.size(); m++)
+    c.members[m].offset = offsets[m];
+  c.size = record->GetValueSize();
+  model_->AddField(ROOT::RVectorField::CreateUntyped(c.name,
+                                                     std::move(record)));
+}
+
+void hepmcNtuple::open()
+{
+  // the writer is created at the first fill so that the compression
+  // settings can still be changed after construction
+  ROOT::RNTupleWriteOptions options;
+  if ( compression_ >= 0 ) options.SetCompression(compression_);
+  try
+    {
+      writer_ = ROOT::RNTupleWriter::Recreate(std::move(model_), ntuplename_,
+                                              filename_, options);
+    }
+  catch (const exception& e)
+    {
+      cerr << "** hepmcNtuple: can't open file " << filename_ << endl
+           << "   " << e.what() << endl;
+      good_ = false;
+      return;
+    }
+
+  entry_ = writer_->CreateEntry();
+  for(size_t c=0; c < scalar_.size(); c++)
+    entry_->BindRawPtr(scalar_[c].name, scalar_[c].address);
+  for(size_t c=0; c < collection_.size(); c++)
+    entry_->BindRawPtr(collection_[c].name, (void*)&collection_[c].buffer);
+}
+
+void hepmcNtuple::setThreads(int n)
+{
+  // with implicit multithreading, the writer compresses pages in parallel
+  if ( n < 2 ) return;
+  if ( ! ROOT::IsImplicitMTEnabled() ) ROOT::EnableImplicitMT(n);
+}
+
+void hepmcNtuple::setCompression(int settings)
+{
+  if ( writer_ )
+    cerr << "** hepmcNtuple: compression must be set before the first fill"
+         << endl;
+  compression_ = settings;
+}
+
+void hepmcNtuple::setFlush(long long n)
+{
+  flush_ = n;
+}
+
+void hepmcNtuple::fill()
+{
+  if ( ! good_ ) return;
+  if ( ! writer_ )
+    {
+      open();
+      if ( ! good_ ) return;
+    }
+
+  // gather the columns of the bag into records
+  for(size_t c=0; c < collection_.size(); c++)
+    {
+      collection& col = collection_[c];
+      int n = *col.count;
+      col.buffer.resize(n * col.size);
+      char* buffer = col.buffer.data();
+      for(size_t m=0; m < col.members.size(); m++)
+        col.members[m].copy(buffer + col.members[m].offset, col.size,
+                            col.members[m].address(), n);
+    }
+  double t = seconds();
+  writer_->Fill(*entry_);
+  entries_++;
+  if ( flush_ > 0 && entries_ % flush_ == 0 ) writer_->CommitCluster();
+  write_ += seconds() - t;
+}
+
+void hepmcNtuple::close()
+{
+  double t = seconds();
+  if ( good_ && ! writer_ && model_ ) open();
+  entry_.reset();
+  writer_.reset();
+  write_ += seconds() - t;
+}
+
+long long hepmcNtuple::entries()
+{
+  return entries_;
+}
+
+long long hepmcNtuple::bytes()
+{
+  // the writer does not count the bytes it writes
+  struct stat info;
+  return stat(filename_.c_str(), &info) == 0 ? (long long)info.st_size : 0;
+}
+
+void hepmcNtuple::ls()
+{
+  for(size_t ii=0; ii < ls_.size(); ii++)
+    printf("%4d\t%s\n", (int)ii+1, ls_[ii].c_str());
+}
+#else
+hepmcNtuple::hepmcNtuple(string filename, Bag& bag, string version,
+                         bool kinematics, string ntuplename)
+  : hepmcOutput()
+{
+  cerr << "** hepmcNtuple: RNTuple output needs ROOT 6.36 or later" << endl;
+  good_ = false;
+}
+
+hepmcNtuple::~hepmcNtuple() {}
+void hepmcNtuple::fill() {}
+void hepmcNtuple::setThreads(int n) {}
+void hepmcNtuple::setCompression(int settings) {}
+void hepmcNtuple::setFlush(long long n) {}
+void hepmcNtuple::close() {}
+long long hepmcNtuple::entries() { return 0; }
+long long hepmcNtuple::bytes() { return 0; }
+void hepmcNtuple::ls() {}
+#endif
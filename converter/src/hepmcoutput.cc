@@ -0,0 +1,53 @@
+// -----------------------------------------------------------------------------
+// File: hepmcoutput.cc
+// Description: model an output of converted events
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <iostream>
+#include <sstream>
+#include "hepmcoutput.h"
+#include "hepmcarrow.h"
+#include "hepmctree.h"
+#include "hepmcntuple.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+hepmcOutput::hepmcOutput()
+  : good_(true),
+    write_(0)
+{}
+
+hepmcOutput::~hepmcOutput() {}
+
+hepmcOutput* openOutput(string filename, Bag& bag, string version,
+                        string format, string schema, bool resume)
+{
+  if ( format == "tree" )
+    return new hepmcTree(filename, bag, version, schema, TREENAME, resume);
+  if ( resume )
+    {
+      cerr << "** openOutput: only format tree can be resumed" << endl;
+      return 0;
+    }
+  // only the derived kinematic variables can be added to the other formats
+  bool kinematics = false;
+  istringstream words(schema);
+  string word;
+  while ( getline(words, word, ',') )
+    {
+      if ( word == "kinematics" )
+        kinematics = true;
+      else if ( word != "full" )
+        {
+          cerr << "** openOutput: schema " << word
+               << " is only available for format tree" << endl;
+          return 0;
+        }
+    }
+  if ( format == "rntuple" )
+    return new hepmcNtuple(filename, bag, version, kinematics);
+  else if ( format == "arrow" )
+    return new hepmcArrow(filename, bag, version, kinematics);
+  cerr << "** openOutput: unknown format " << format << endl;
+  return 0;
+}
@@ -0,0 +1,774 @@
+// -----------------------------------------------------------------------------
+// File: hepmcparser.cc
+// Description: parse HepMC2 and HepMC3 event records in place
+//
+// HepMC2 (IO_GenEvent)
+//
+//    E evt-number n-mpi scale alphaQCD alphaQED process-id signal-vertex
+//      n-vertices beam1 beam2 n-random random.. n-weights weights..
+//    C cross-section error
+//    F parton1 parton2 x1 x2 Q2 x1f x2f id1 id2
+//    V barcode id x y z ctau n-orphans n-out n-weights weights..
+//    P barcode pid px py pz energy mass status theta phi end-vertex n-flow ..
+//
+// The particles of a vertex follow immediately after the vertex: first the
+// incoming particles that have no production vertex (the orphans, e.g., the
+// beam particles), then the outgoing particles.
+//
+// HepMC3 (Asciiv3)
+//
+//    E evt-number n-vertices n-particles [@ x y z t]
+//    U momentum-unit length-unit
+//    W weights..
+//    A id name value..
+//    P id production-vertex pid px py pz energy mass status
+//    V id status [incoming,..] [@ x y z t]
+//
+// Here a particle is linked to its production vertex and a vertex to its
+// incoming particles. A vertex whose only incoming particle is particle i
+// is usually not written; its outgoing particles then give i, a positive
+// number, as their production vertex. Attributes with id 0 pertain to the
+// event.
+//
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include "hepmcparser.h"
+#include "kinematics.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  inline const char* getXsection(const char* q, const char* end, Bag& bag)
+  {
+    q = getField(q, end, bag.Xsection_value);
+    q = getField(q, end, bag.Xsection_error);
+    return q;
+  }
+
+  inline const char* getPDF(const char* q, const char* end, Bag& bag)
+  {
+    q = getField(q, end, bag.PDF_parton1);
+    q = getField(q, end, bag.PDF_parton2);
+    q = getField(q, end, bag.PDF_x1);
+    q = getField(q, end, bag.PDF_x2);
+    q = getField(q, end, bag.PDF_Q2);
+    q = getField(q, end, bag.PDF_x1f);
+    q = getField(q, end, bag.PDF_x2f);
+    q = getField(q, end, bag.PDF_id1);
+    q = getField(q, end, bag.PDF_id2);
+    return q;
+  }
+
+  /** Return the count n given in the record [begin, end), or, if the
+      record is too short to hold n lines, the largest count it could
+      hold. The count is used only to size tables.
+  */
+  inline size_t sizeHint(int n, const char* begin, const char* end)
+  {
+    size_t most = (end - begin) / 8;
+    return (size_t)n < most ? (size_t)n : most;
+  }
+
+  /// True if the field at p is the given word.
+  inline bool isWord(const char* p, const char* end, const char* word)
+  {
+    size_t n = strlen(word);
+    return (size_t)(end - p) > n && memcmp(p, word, n) == 0 &&
+      (p[n] == ' ' || p[n] == '\t' || p[n] == '\n');
+  }
+}
+
+hepmcParser::hepmcParser()
+  : format_(2),
+    limit_(0),
+    select_(0),
+    kinematics_(false),
+    times_(stageTimes()),
+    pvertex_(vector<int>()),
+    prodv_(vector<int>()),
+    endv_(vector<int>()),
+    vertex_(barcodeMap()),
+    nvertex_(0),
+    particle_(barcodeMap()),
+    implicit_(vector<int>()),
+    vfirst_(vector<int>()),
+    vset_(vector<char>()),
+    incoming_(vector<pair<int, int> >()),
+    vbarcode_(vector<int>()),
+    vposition_(vector<double>()),
+    vin_(vector<int>()),
+    vout_(vector<int>()),
+    vnext_(vector<int>()),
+    vinlist_(vector<int>()),
+    voutlist_(vector<int>()),
+    kept_(vector<int>()),
+    merged_(false),
+    vroot_(vector<int>()),
+    vused_(vector<int>()),
+    mprodv_(vector<int>()),
+    mendv_(vector<int>())
+{}
+
+hepmcParser::~hepmcParser() {}
+
+bool hepmcParser::fail(const char* p, const char* end)
+{
+  const char* q = nextLine(p, end);
+  cerr << "** hepmcParser: faulty event record" << endl
+       << string(p, q) << endl;
+  return false;
+}
+
+void hepmcParser::clear(Bag& bag)
+{
+  bag.Event_numberP = 0;
+
+  // cross section and PDF info are optional, so zero them to make each
+  // event self-contained
+  bag.Xsection_value = bag.Xsection_error = 0;
+  bag.PDF_parton1 = bag.PDF_parton2 = bag.PDF_id1 = bag.PDF_id2 = 0;
+  bag.PDF_x1 = bag.PDF_x2 = bag.PDF_Q2 = bag.PDF_x1f = bag.PDF_x2f = 0;
+}
+
+void hepmcParser::reserve(Bag& bag, int index)
+{
+  bag.reserve(index + 1);
+  if ( pvertex_.size() < bag.capacity() )
+    {
+      pvertex_.resize(bag.capacity());
+      prodv_.resize(bag.capacity());
+      endv_.resize(bag.capacity());
+      implicit_.resize(bag.capacity());
+    }
+}
+
+bool hepmcParser::operator()(const char* begin, const char* end, Bag& bag)
+{
+  double t0 = seconds();
+  if ( ! (format_ == 3 ? parse3(begin, end, bag) : parse2(begin, end, bag)) )
+    return false;
+  double t1 = seconds();
+  merged_ = false;
+  if ( select_ ) select(bag);
+  if ( limit_ > 0 && bag.Event_numberP > limit_ ) truncate(bag);
+  double t2 = seconds();
+  link(bag);
+  vertices(bag);
+  double t3 = seconds();
+  if ( kinematics_ ) computeKinematics(bag);
+  double t4 = seconds();
+  times_.parse  += t1 - t0;
+  times_.select += t2 - t1;
+  times_.link   += t3 - t2;
+  times_.kinematics += t4 - t3;
+  return true;
+}
+
+bool hepmcParser::parse2(const char* begin, const char* end, Bag& bag)
+{
+  const char* p = begin;
+  if ( p >= end || *p != 'E' ) return fail(p, end);
+
+  const char* q = p + 1;
+  q = getField(q, end, bag.Event_number);
+  q = getField(q, end, bag.Event_numberMP);  // number of multi-particle interactions
+  q = getField(q, end, bag.Event_scale);
+  q = getField(q, end, bag.Event_alphaQCD);
+  q = getField(q, end, bag.Event_alphaQED);
+  q = getField(q, end, bag.Event_processID);
+  q = getField(q, end, bag.Event_barcodeSPV);
+  q = getField(q, end, bag.Event_numberV);   // number of vertices in event
+  q = getField(q, end, bag.Event_barcodeBP1); // barcode beam particle 1
+  q = getField(q, end, bag.Event_barcodeBP2); // barcode beam particle 2
+  if ( q == 0 || bag.Event_numberV < 0 ) return fail(p, end);
+  clear(bag);
+
+  // event header lines precede the first vertex
+  p = nextLine(p, end);
+  while ( p < end && *p != 'V' )
+    {
+      q = p + 1;
+      switch ( *p )
+        {
+        case 'C':
+          // CROSS SECTION
+          q = getXsection(q, end, bag);
+          break;
+
+        case 'F':
+          // PDF INFO
+          q = getPDF(q, end, bag);
+          break;
+
+        case 'E':
+          // start of next event: vertices are missing
+          return fail(p, end);
+
+        default:
+          break;
+        }
+      if ( q == 0 ) return fail(p, end);
+      p = nextLine(p, end);
+    }
+
+  nvertex_ = 0;
+  vertex_.clear(sizeHint(bag.Event_numberV, begin, end));
+
+  for(int nv=0; nv < bag.Event_numberV; nv++)
+    {
+      // VERTEX
+      if ( p >= end || *p != 'V' ) return fail(p, end);
+
+      int vbarcode = 0;
+      int norphans = 0;
+      int nout = 0;
+      double x = 0, y = 0, z = 0, ctau = 0;
+      q = getField(p + 1, end, vbarcode);
+      q = skipField(q, end);
+      q = getField(q, end, x);
+      q = getField(q, end, y);
+      q = getField(q, end, z);
+      q = getField(q, end, ctau);
+      q = getField(q, end, norphans);
+      q = getField(q, end, nout);
+      if ( q == 0 ) return fail(p, end);
+      p = nextLine(p, end);
+      vertex_.insert(vbarcode, nv);
+      newVertex();
+      vbarcode_[nv] = vbarcode;
+      vposition_[4*nv]   = x;
+      vposition_[4*nv+1] = y;
+      vposition_[4*nv+2] = z;
+      vposition_[4*nv+3] = ctau;
+      vset_[nv] = 1;
+
+      // particles pertaining to this vertex follow immediately
+      // after the vertex
+      for(int ii=0; ii < norphans + nout; ii++)
+        {
+          if ( p >= end || *p != 'P' ) return fail(p, end);
+
+          int index = bag.Event_numberP;
+          reserve(bag, index);
+
+          bag.Particle_x[index]    = x;
+          bag.Particle_y[index]    = y;
+          bag.Particle_z[index]    = z;
+          bag.Particle_ctau[index] = ctau;
+
+          int barcode = 0;
+          q = getField(p + 1, end, barcode);
+          q = getField(q, end, bag.Particle_pid[index]);
+          q = getField(q, end, bag.Particle_px[index]);
+          q = getField(q, end, bag.Particle_py[index]);
+          q = getField(q, end, bag.Particle_pz[index]);
+          q = getField(q, end, bag.Particle_energy[index]);
+          q = getField(q, end, bag.Particle_mass[index]);
+          q = getField(q, end, bag.Particle_status[index]);
+          q = skipField(q, end); // theta
+          q = skipField(q, end); // phi
+          q = getField(q, end, pvertex_[index]);
+          if ( q == 0 ) return fail(p, end);
+          bag.Particle_barcode[index] = barcode;
+          prodv_[index] = ii < norphans ? -1 : nv;
+          bag.Event_numberP++;
+          p = nextLine(p, end);
+        }
+    }
+
+  // find end vertices
+  for(int index=0; index < bag.Event_numberP; index++)
+    endv_[index] = vertex_.find(pvertex_[index]);
+  return true;
+}
+
+bool hepmcParser::parse3(const char* begin, const char* end, Bag& bag)
+{
+  const char* p = begin;
+  if ( p >= end || *p != 'E' ) return fail(p, end);
+
+  int nparticles = 0;
+  const char* q = p + 1;
+  q = getField(q, end, bag.Event_number);
+  q = getField(q, end, bag.Event_numberV);
+  q = getField(q, end, nparticles);
+  if ( q == 0 || bag.Event_numberV < 0 || nparticles < 0 )
+    return fail(p, end);
+
+  // the event position is the default position of its vertices
+  double shift[4] = {0, 0, 0, 0};
+  q = skipSpace(q, end);
+  if ( q < end && *q == '@' )
+    {
+      q++;
+      for(int i=0; i < 4; i++) q = getField(q, end, shift[i]);
+      if ( q == 0 ) return fail(p, end);
+    }
+
+  clear(bag);
+  bag.Event_numberMP   = 0;
+  bag.Event_scale      = 0;
+  bag.Event_alphaQCD   = 0;
+  bag.Event_alphaQED   = 0;
+  bag.Event_processID  = 0;
+  bag.Event_barcodeSPV = 0;
+  bag.Event_barcodeBP1 = 0;
+  bag.Event_barcodeBP2 = 0;
+
+  nvertex_ = 0;
+  vertex_.clear(sizeHint(bag.Event_numberV, begin, end));
+  particle_.clear(sizeHint(nparticles, begin, end));
+  incoming_.clear();
+
+  for(p = nextLine(p, end); p < end; p = nextLine(p, end))
+    {
+      q = p + 1;
+      switch ( *p )
+        {
+        case 'P':
+          {
+            // PARTICLE
+            int index = bag.Event_numberP;
+            reserve(bag, index);
+
+            int id = 0;
+            q = getField(q, end, id);
+            q = getField(q, end, pvertex_[index]);
+            q = getField(q, end, bag.Particle_pid[index]);
+            q = getField(q, end, bag.Particle_px[index]);
+            q = getField(q, end, bag.Particle_py[index]);
+            q = getField(q, end, bag.Particle_pz[index]);
+            q = getField(q, end, bag.Particle_energy[index]);
+            q = getField(q, end, bag.Particle_mass[index]);
+            q = getField(q, end, bag.Particle_status[index]);
+            if ( q == 0 ) return fail(p, end);
+            bag.Particle_barcode[index] = id;
+            particle_.insert(id, index);
+            endv_[index] = -1;
+            implicit_[index] = -1;
+            bag.Event_numberP++;
+
+            // particles without production vertex are the beams
+            if ( pvertex_[index] == 0 )
+              {
+                if ( bag.Event_barcodeBP1 == 0 )
+                  bag.Event_barcodeBP1 = id;
+                else if ( bag.Event_barcodeBP2 == 0 )
+                  bag.Event_barcodeBP2 = id;
+              }
+          }
+          break;
+
+        case 'V':
+          {
+            // VERTEX
+            int id = 0;
+            int v = nvertex_;
+            newVertex();
+            q = getField(q, end, id);
+            q = skipField(q, end); // status
+            if ( q == 0 ) return fail(p, end);
+            vertex_.insert(id, v);
+            vbarcode_[v] = id;
+
+            // incoming particles
+            q = skipSpace(q, end);
+            if ( q < end && *q == '[' )
+              {
+                q++;
+                while ( q != 0 && q < end && *q != ']' )
+                  {
+                    int in = 0;
+                    q = getField(q, end, in);
+                    if ( q == 0 ) break;
+                    if ( vfirst_[v] == 0 ) vfirst_[v] = in;
+                    incoming_.push_back(make_pair(in, v));
+                    if ( q < end && *q == ',' ) q++;
+                  }
+                if ( q == 0 || q >= end ) return fail(p, end);
+                q++;
+              }
+
+            // position
+            q = skipSpace(q, end);
+            if ( q < end && *q == '@' )
+              {
+                double* x = &vposition_[4*v];
+                q++;
+                for(int i=0; i < 4; i++) q = getField(q, end, x[i]);
+                if ( q == 0 ) return fail(p, end);
+                vset_[v] = 1;
+              }
+          }
+          break;
+
+        case 'A':
+          {
+            // ATTRIBUTE
+            int id = 0;
+            q = getField(q, end, id);
+            if ( q == 0 ) return fail(p, end);
+            if ( id != 0 ) break;
+            q = skipSpace(q, end);
+            const char* name = q;
+            q = skipField(q, end);
+            if ( isWord(name, end, "GenCrossSection") )
+              q = getXsection(q, end, bag);
+            else if ( isWord(name, end, "GenPdfInfo") )
+              q = getPDF(q, end, bag);
+            else if ( isWord(name, end, "mpi") )
+              q = getField(q, end, bag.Event_numberMP);
+            else if ( isWord(name, end, "event_scale") )
+              q = getField(q, end, bag.Event_scale);
+            else if ( isWord(name, end, "alphaQCD") )
+              q = getField(q, end, bag.Event_alphaQCD);
+            else if ( isWord(name, end, "alphaQED") )
+              q = getField(q, end, bag.Event_alphaQED);
+            else if ( isWord(name, end, "signal_process_id") )
+              q = getField(q, end, bag.Event_processID);
+            else if ( isWord(name, end, "signal_process_vertex") )
+              q = getField(q, end, bag.Event_barcodeSPV);
+            if ( q == 0 ) return fail(p, end);
+          }
+          break;
+
+        case 'E':
+          // start of next event
+          return fail(p, end);
+
+        default:
+          // U, W and the trailer carry nothing for the tree
+          break;
+        }
+    }
+  if ( bag.Event_numberP != nparticles ) return fail(begin, end);
+
+  // link the incoming particles to their end vertices
+  for(size_t i=0; i < incoming_.size(); i++)
+    {
+      int index = particle_.find(incoming_[i].first);
+      if ( index >= 0 ) endv_[index] = incoming_[i].second;
+    }
+
+  // find production vertices; a positive number is the incoming particle
+  // of an implicit vertex
+  for(int index=0; index < bag.Event_numberP; index++)
+    {
+      int code = pvertex_[index];
+      int v = -1;
+      if ( code < 0 )
+        v = vertex_.find(code);
+      else if ( code > 0 )
+        {
+          int mother = particle_.find(code);
+          if ( mother >= 0 )
+            {
+              if ( implicit_[mother] < 0 )
+                {
+                  implicit_[mother] = nvertex_;
+                  newVertex();
+                  vfirst_[implicit_[mother]] = code;
+                  endv_[mother] = implicit_[mother];
+                }
+              v = implicit_[mother];
+            }
+        }
+      prodv_[index] = v;
+    }
+
+  // as in HepMC3 (GenVertex::position), a vertex without position is
+  // placed at the production vertex of the first of its incoming particles
+  // that has one or, if there is none, at the event position; going
+  // backwards, the first such particle is the last one recorded
+  for(int i=(int)incoming_.size()-1; i >= 0; i--)
+    {
+      int mother = particle_.find(incoming_[i].first);
+      if ( mother >= 0 && prodv_[mother] >= 0 )
+        vfirst_[incoming_[i].second] = incoming_[i].first;
+    }
+
+  for(int v=0; v < nvertex_; v++)
+    {
+      // follow the chain of unplaced vertices up to a placed one
+      int u = v;
+      int steps = 0;
+      const double* from = shift;
+      while ( ! vset_[u] )
+        {
+          int mother = vfirst_[u] != 0 ? particle_.find(vfirst_[u]) : -1;
+          if ( mother < 0 || prodv_[mother] < 0 || steps > nvertex_ ) break;
+          u = prodv_[mother];
+          steps++;
+        }
+      if ( vset_[u] ) from = &vposition_[4*u];
+
+      // and place the vertices of the chain
+      u = v;
+      for(int k=0; k <= steps && ! vset_[u]; k++)
+        {
+          double* x = &vposition_[4*u];
+          for(int i=0; i < 4; i++) x[i] = from[i];
+          vset_[u] = 1;
+          if ( k < steps ) u = prodv_[particle_.find(vfirst_[u])];
+        }
+    }
+
+  for(int index=0; index < bag.Event_numberP; index++)
+    {
+      int v = prodv_[index];
+      const double* x = v >= 0 ? &vposition_[4*v] : shift;
+      bag.Particle_x[index]    = x[0];
+      bag.Particle_y[index]    = x[1];
+      bag.Particle_z[index]    = x[2];
+      bag.Particle_ctau[index] = x[3];
+    }
+  return true;
+}
+
+void hepmcParser::newVertex()
+{
+  int v = nvertex_++;
+  if ( (int)vfirst_.size() < nvertex_ )
+    {
+      size_t n = vfirst_.size() > 0 ? 2 * vfirst_.size() : 64;
+      vfirst_.resize(n);
+      vset_.resize(n);
+      vbarcode_.resize(n);
+      vposition_.resize(4 * n);
+    }
+  vfirst_[v] = 0;
+  vset_[v] = 0;
+  vbarcode_[v] = 0;
+}
+
+namespace {
+  /** Make offset[v]..offset[v+1]-1 the positions in list of the particles
+      whose vertex[index] is v, in index order.
+  */
+  void sortByVertex(const std::vector<int>& vertex, int n, int nvertex,
+                    std::vector<int>& offset, std::vector<int>& next,
+                    std::vector<int>& list)
+  {
+    offset.assign(nvertex + 1, 0);
+    for(int index=0; index < n; index++)
+      if ( vertex[index] >= 0 ) offset[vertex[index]+1]++;
+    for(int v=0; v < nvertex; v++) offset[v+1] += offset[v];
+    list.resize(offset[nvertex]);
+    next.assign(offset.begin(), offset.end() - 1);
+    for(int index=0; index < n; index++)
+      if ( vertex[index] >= 0 ) list[next[vertex[index]]++] = index;
+  }
+}
+
+void hepmcParser::link(Bag& bag)
+{
+  int n = bag.Event_numberP;
+
+  // once particles have been dropped, link through the merged vertices
+  if ( merged_ )
+    {
+      mprodv_.resize(n);
+      mendv_.resize(n);
+      for(int index=0; index < n; index++)
+        {
+          mprodv_[index] = prodv_[index] < 0 ? -1 : root(prodv_[index]);
+          mendv_[index]  = endv_[index]  < 0 ? -1 : root(endv_[index]);
+        }
+    }
+  const vector<int>& prodv = merged_ ? mprodv_ : prodv_;
+  const vector<int>& endv  = merged_ ? mendv_  : endv_;
+
+  sortByVertex(prodv, n, nvertex_, vout_, vnext_, voutlist_);
+  sortByVertex(endv,  n, nvertex_, vin_,  vnext_, vinlist_);
+
+  // link particles to the outgoing particles of their end vertices; a
+  // particle is never its own daughter, which it could become only by
+  // merging
+  bag.Event_numberD = 0;
+  for(int index=0; index < n; index++)
+    {
+      int begin = bag.Particle_doffset[index] = bag.Event_numberD;
+
+      int v = endv[index];
+      int first = v < 0 ? 0 : vout_[v];
+      int last  = v < 0 ? 0 : vout_[v+1];
+      bag.reserveDaughters(bag.Event_numberD + last - first);
+      for(int d=first; d < last; d++)
+        if ( voutlist_[d] != index )
+          bag.Daughter_index[bag.Event_numberD++] = voutlist_[d];
+
+      int count = bag.Event_numberD - begin;
+      bag.Particle_d1[index] = count > 0 ? bag.Daughter_index[begin] : -1;
+      bag.Particle_d2[index] = count > 1 ?
+        bag.Daughter_index[bag.Event_numberD - 1] : -1;
+    }
+
+  // link particles to the incoming particles of their production vertices
+  bag.Event_numberM = 0;
+  for(int index=0; index < n; index++)
+    {
+      int begin = bag.Particle_moffset[index] = bag.Event_numberM;
+
+      int v = prodv[index];
+      int first = v < 0 ? 0 : vin_[v];
+      int last  = v < 0 ? 0 : vin_[v+1];
+      bag.reserveMothers(bag.Event_numberM + last - first);
+      for(int m=first; m < last; m++)
+        if ( vinlist_[m] != index )
+          bag.Mother_index[bag.Event_numberM++] = vinlist_[m];
+
+      int count = bag.Event_numberM - begin;
+      bag.Particle_m1[index] = count > 0 ? bag.Mother_index[begin] : -1;
+      bag.Particle_m2[index] = count > 1 ?
+        bag.Mother_index[bag.Event_numberM - 1] : -1;
+    }
+}
+
+void hepmcParser::vertices(Bag& bag)
+{
+  // once particles have been dropped, keep only the production vertices
+  // of the remaining ones
+  int nv = nvertex_;
+  if ( merged_ )
+    {
+      vused_.assign(nvertex_, -1);
+      for(int index=0; index < bag.Event_numberP; index++)
+        if ( prodv_[index] >= 0 ) vused_[prodv_[index]] = 0;
+      nv = 0;
+      for(int v=0; v < nvertex_; v++)
+        if ( vused_[v] == 0 ) vused_[v] = nv++;
+    }
+
+  bag.Event_numberVX = nv;
+  bag.reserveVertices(nv);
+  for(int v=0; v < nvertex_; v++)
+    {
+      int k = merged_ ? vused_[v] : v;
+      if ( k < 0 ) continue;
+      const double* x = &vposition_[4*v];
+      bag.Vertex_barcode[k] = vbarcode_[v];
+      bag.Vertex_x[k]    = x[0];
+      bag.Vertex_y[k]    = x[1];
+      bag.Vertex_z[k]    = x[2];
+      bag.Vertex_ctau[k] = x[3];
+    }
+  for(int index=0; index < bag.Event_numberP; index++)
+    {
+      int v = prodv_[index];
+      bag.Particle_vertex[index] = v < 0 || ! merged_ ? v : vused_[v];
+    }
+}
+
+int hepmcParser::root(int v)
+{
+  int r = v;
+  while ( vroot_[r] != r ) r = vroot_[r];
+  while ( vroot_[v] != r )
+    {
+      int next = vroot_[v];
+      vroot_[v] = r;
+      v = next;
+    }
+  return r;
+}
+
+namespace {
+  /// Return 0 for final-state particles, 1 for the beams and the particles
+  /// of the hard process (HepMC2 status 3 and 4, Pythia8 status 21-29), and
+  /// 2 for all others.
+  inline int priority(int status)
+  {
+    if ( status == 1 ) return 0;
+    if ( status == 3 || status == 4 || (status >= 21 && status <= 29) )
+      return 1;
+    return 2;
+  }
+
+  template <class T>
+  inline void compact(T* column, const std::vector<int>& kept, int n)
+  {
+    for(int index=0; index < n; index++)
+      if ( kept[index+1] > kept[index] ) column[kept[index]] = column[index];
+  }
+}
+
+void hepmcParser::select(Bag& bag)
+{
+  int n = bag.Event_numberP;
+  kept_.resize(n + 1);
+  kept_[0] = 0;
+  for(int index=0; index < n; index++)
+    kept_[index+1] = kept_[index] + ((*select_)(bag, index) ? 1 : 0);
+  drop(bag);
+}
+
+void hepmcParser::truncate(Bag& bag)
+{
+  int n = bag.Event_numberP;
+
+  // find the highest priority r whose particles do not all fit and the number
+  // of them that do
+  int count[3] = {0, 0, 0};
+  for(int index=0; index < n; index++)
+    count[priority(bag.Particle_status[index])]++;
+  int r = 0;
+  int room = limit_;
+  while ( r < 2 && count[r] <= room ) room -= count[r++];
+
+  kept_.resize(n + 1);
+  kept_[0] = 0;
+  for(int index=0; index < n; index++)
+    {
+      int k = priority(bag.Particle_status[index]);
+      bool keep = k < r || (k == r && room-- > 0);
+      kept_[index+1] = kept_[index] + (keep ? 1 : 0);
+    }
+  drop(bag);
+}
+
+void hepmcParser::drop(Bag& bag)
+{
+  int n = bag.Event_numberP;
+  if ( kept_[n] == n ) return;
+
+  // a dropped particle joins its production and end vertices, so that
+  // the remaining particles are linked to their nearest remaining
+  // ancestors and descendants
+  if ( ! merged_ )
+    {
+      vroot_.resize(nvertex_);
+      for(int v=0; v < nvertex_; v++) vroot_[v] = v;
+      merged_ = true;
+    }
+  for(int index=0; index < n; index++)
+    {
+      if ( kept_[index+1] > kept_[index] ) continue;
+      if ( prodv_[index] < 0 || endv_[index] < 0 ) continue;
+      int a = root(prodv_[index]);
+      int b = root(endv_[index]);
+      if ( a < b )
+        vroot_[b] = a;
+      else
+        vroot_[a] = b;
+    }
+
+  // keep the particles in their original order; kept_[i] is the number of
+  // particles kept before particle i, so that it is the new index of
+  // particle i if it is kept, and kept_[n] is the number kept
+  compact(bag.Particle_x.data(),       kept_, n);
+  compact(bag.Particle_y.data(),       kept_, n);
+  compact(bag.Particle_z.data(),       kept_, n);
+  compact(bag.Particle_ctau.data(),    kept_, n);
+  compact(bag.Particle_barcode.data(), kept_, n);
+  compact(bag.Particle_pid.data(),     kept_, n);
+  compact(bag.Particle_px.data(),      kept_, n);
+  compact(bag.Particle_py.data(),      kept_, n);
+  compact(bag.Particle_pz.data(),      kept_, n);
+  compact(bag.Particle_energy.data(),  kept_, n);
+  compact(bag.Particle_mass.data(),    kept_, n);
+  compact(bag.Particle_status.data(),  kept_, n);
+  compact(prodv_.data(),               kept_, n);
+  compact(endv_.data(),                kept_, n);
+  bag.Event_numberP = kept_[n];
+}
@@ -0,0 +1,510 @@
+// -----------------------------------------------------------------------------
+// File: hepmcsource.cc
+// Description: sources of bytes for the buffered HepMC stream
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_LZMA
+#include <lzma.h>
+#endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#include "hepmcsource.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+fileSource::fileSource(string filename)
+  : hepmcSource(),
+    fd_(filename == "-" ? 0 : open(filename.c_str(), O_RDONLY))
+{
+  if ( fd_ < 0 )
+    {
+      cerr << "** hepmcSource: can't open file " << filename << endl;
+      good_ = false;
+    }
+}
+
+fileSource::~fileSource()
+{
+  if ( fd_ > 0 ) close(fd_);
+}
+
+size_t fileSource::read(char* buffer, size_t size)
+{
+  if ( fd_ < 0 ) return 0;
+
+  // unlike fread, return whatever a pipe has to offer rather than wait
+  // until the buffer is full, so that events are converted as they arrive
+  while ( true )
+    {
+      ssize_t n = ::read(fd_, buffer, size);
+      if ( n >= 0 ) return n;
+      if ( errno == EINTR ) continue;
+      cerr << "** hepmcSource: " << strerror(errno) << endl;
+      good_ = false;
+      return 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+#ifdef HAVE_ZLIB
+gzipSource::gzipSource(string filename)
+  : hepmcSource(),
+    file_(gzopen(filename.c_str(), "rb"))
+{
+  if ( file_ == 0 )
+    {
+      cerr << "** hepmcSource: can't open file " << filename << endl;
+      good_ = false;
+      return;
+    }
+  gzbuffer((gzFile)file_, 1 << 18);
+}
+
+gzipSource::~gzipSource()
+{
+  if ( file_ ) gzclose((gzFile)file_);
+}
+
+size_t gzipSource::read(char* buffer, size_t size)
+{
+  if ( file_ == 0 ) return 0;
+  if ( size > (1U << 30) ) size = 1U << 30;
+  int n = gzread((gzFile)file_, buffer, (unsigned int)size);
+  if ( n < 0 )
+    {
+      int code = 0;
+      cerr << "** hepmcSource: " << gzerror((gzFile)file_, &code) << endl;
+      good_ = false;
+      return 0;
+    }
+  return n;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+#ifdef HAVE_LZMA
+xzSource::xzSource(string filename)
+  : hepmcSource(),
+    file_(fopen(filename.c_str(), "rb")),
+    stream_(0),
+    input_(vector<char>(1 << 18)),
+    eof_(false)
+{
+  if ( file_ == 0 )
+    {
+      cerr << "** hepmcSource: can't open file " << filename << endl;
+      good_ = false;
+      return;
+    }
+  lzma_stream init = LZMA_STREAM_INIT;
+  lzma_stream* strm = new lzma_stream(init);
+  stream_ = strm;
+  if ( lzma_stream_decoder(strm, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK )
+    {
+      cerr << "** hepmcSource: can't initialize xz decoder" << endl;
+      good_ = false;
+    }
+}
+
+xzSource::~xzSource()
+{
+  if ( stream_ )
+    {
+      lzma_end((lzma_stream*)stream_);
+      delete (lzma_stream*)stream_;
+    }
+  if ( file_ ) fclose(file_);
+}
+
+size_t xzSource::read(char* buffer, size_t size)
+{
+  if ( ! good_ ) return 0;
+
+  lzma_stream* strm = (lzma_stream*)stream_;
+  strm->next_out  = (uint8_t*)buffer;
+  strm->avail_out = size;
+  while ( strm->avail_out > 0 )
+    {
+      if ( strm->avail_in == 0 && ! eof_ )
+        {
+          strm->next_in  = (const uint8_t*)input_.data();
+          strm->avail_in = fread(input_.data(), 1, input_.size(), file_);
+          if ( strm->avail_in == 0 ) eof_ = true;
+        }
+      lzma_ret ret = lzma_code(strm, eof_ ? LZMA_FINISH : LZMA_RUN);
+      if ( ret == LZMA_STREAM_END ) break;
+      if ( ret != LZMA_OK )
+        {
+          cerr << "** hepmcSource: xz decoder error " << ret << endl;
+          good_ = false;
+          break;
+        }
+    }
+  return size - strm->avail_out;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+#ifdef HAVE_ZSTD
+zstdSource::zstdSource(string filename)
+  : hepmcSource(),
+    file_(fopen(filename.c_str(), "rb")),
+    stream_(ZSTD_createDStream()),
+    input_(vector<char>(ZSTD_DStreamInSize())),
+    pos_(0),
+    size_(0)
+{
+  if ( file_ == 0 )
+    {
+      cerr << "** hepmcSource: can't open file " << filename << endl;
+      good_ = false;
+      return;
+    }
+  ZSTD_initDStream((ZSTD_DStream*)stream_);
+}
+
+zstdSource::~zstdSource()
+{
+  ZSTD_freeDStream((ZSTD_DStream*)stream_);
+  if ( file_ ) fclose(file_);
+}
+
+size_t zstdSource::read(char* buffer, size_t size)
+{
+  if ( ! good_ ) return 0;
+
+  ZSTD_outBuffer out = {buffer, size, 0};
+  while ( out.pos < out.size )
+    {
+      if ( pos_ == size_ )
+        {
+          size_ = fread(input_.data(), 1, input_.size(), file_);
+          pos_  = 0;
+          if ( size_ == 0 ) break;
+        }
+      ZSTD_inBuffer in = {input_.data(), size_, pos_};
+      size_t code = ZSTD_decompressStream((ZSTD_DStream*)stream_, &out, &in);
+      pos_ = in.pos;
+      if ( ZSTD_isError(code) )
+        {
+          cerr << "** hepmcSource: " << ZSTD_getErrorName(code) << endl;
+          good_ = false;
+          break;
+        }
+    }
+  return out.pos;
+}
+
+zstdFrameSource::zstdFrameSource(string filename, int nthreads)
+  : hepmcSource(),
+    data_(0),
+    size_(0),
+    frame_(vector<pair<size_t, size_t> >()),
+    next_(0),
+    pool_(0),
+    busy_(deque<future<vector<char>*> >()),
+    current_(0),
+    pos_(0)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat info;
+  if ( fd < 0 || fstat(fd, &info) != 0 )
+    {
+      cerr << "** hepmcSource: can't open file " << filename << endl;
+      if ( fd >= 0 ) close(fd);
+      good_ = false;
+      return;
+    }
+  size_ = info.st_size;
+  if ( size_ > 0 )
+    {
+      void* addr = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( addr != MAP_FAILED )
+        {
+          data_ = (const char*)addr;
+          madvise(addr, size_, MADV_SEQUENTIAL);
+        }
+    }
+  close(fd);
+  if ( data_ == 0 )
+    {
+      good_ = false;
+      return;
+    }
+
+  // find frames
+  for(size_t p=0; p < size_;)
+    {
+      size_t n = ZSTD_findFrameCompressedSize(data_ + p, size_ - p);
+      if ( ZSTD_isError(n) )
+        {
+          cerr << "** hepmcSource: " << ZSTD_getErrorName(n) << endl;
+          good_ = false;
+          return;
+        }
+      frame_.push_back(make_pair(p, n));
+      p += n;
+    }
+  pool_ = new threadPool(nthreads);
+}
+
+zstdFrameSource::~zstdFrameSource()
+{
+  if ( pool_ ) delete pool_;
+  while ( ! busy_.empty() )
+    {
+      delete busy_.front().get();
+      busy_.pop_front();
+    }
+  if ( current_ ) delete current_;
+  if ( data_ ) munmap((void*)data_, size_);
+}
+
+vector<char>* zstdFrameSource::decompress(const char* data, size_t size)
+{
+  vector<char>* out = new vector<char>();
+  unsigned long long n = ZSTD_getFrameContentSize(data, size);
+  if ( n != ZSTD_CONTENTSIZE_UNKNOWN && n != ZSTD_CONTENTSIZE_ERROR )
+    {
+      out->resize(n);
+      size_t code = ZSTD_decompress(out->data(), n, data, size);
+      if ( ZSTD_isError(code) )
+        {
+          cerr << "** hepmcSource: " << ZSTD_getErrorName(code) << endl;
+          delete out;
+          return 0;
+        }
+      out->resize(code);
+      return out;
+    }
+
+  // size of frame not recorded, so decompress it as a stream
+  ZSTD_DStream* stream = ZSTD_createDStream();
+  ZSTD_initDStream(stream);
+  ZSTD_inBuffer in = {data, size, 0};
+  size_t code = 1;
+  while ( code != 0 && in.pos < in.size )
+    {
+      size_t pos = out->size();
+      out->resize(pos + ZSTD_DStreamOutSize());
+      ZSTD_outBuffer o = {out->data() + pos, out->size() - pos, 0};
+      code = ZSTD_decompressStream(stream, &o, &in);
+      out->resize(pos + o.pos);
+      if ( ZSTD_isError(code) )
+        {
+          cerr << "** hepmcSource: " << ZSTD_getErrorName(code) << endl;
+          delete out;
+          out = 0;
+          break;
+        }
+    }
+  ZSTD_freeDStream(stream);
+  return out;
+}
+
+size_t zstdFrameSource::read(char* buffer, size_t size)
+{
+  if ( ! good_ ) return 0;
+
+  while ( current_ == 0 || pos_ >= current_->size() )
+    {
+      if ( current_ ) delete current_;
+      current_ = 0;
+
+      // keep two frames per thread in flight
+      while ( next_ < frame_.size() && (int)busy_.size() < 2 * pool_->size() )
+        {
+          const char* data = data_ + frame_[next_].first;
+          size_t size = frame_[next_].second;
+          busy_.push_back(pool_->submit([data, size]()
+                                        { return decompress(data, size); }));
+          next_++;
+        }
+      if ( busy_.empty() ) return 0;
+
+      current_ = busy_.front().get();
+      busy_.pop_front();
+      pos_ = 0;
+      if ( current_ == 0 )
+        {
+          good_ = false;
+          return 0;
+        }
+    }
+
+  size_t n = current_->size() - pos_;
+  if ( n > size ) n = size;
+  memcpy(buffer, current_->data() + pos_, n);
+  pos_ += n;
+  return n;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+asyncSource::asyncSource(hepmcSource* source, size_t blocksize, size_t nblocks)
+  : hepmcSource(),
+    source_(source),
+    blocks_(vector<block*>()),
+    free_(deque<block*>()),
+    full_(deque<block*>()),
+    current_(0),
+    pos_(0),
+    eof_(false),
+    done_(false)
+{
+  good_ = source_->good();
+  for(size_t i=0; i < nblocks; i++)
+    {
+      block* b = new block();
+      b->data.resize(blocksize);
+      b->size = 0;
+      blocks_.push_back(b);
+      free_.push_back(b);
+    }
+  thread_ = thread(&asyncSource::run, this);
+}
+
+asyncSource::~asyncSource()
+{
+  {
+    lock_guard<mutex> lock(mutex_);
+    done_ = true;
+  }
+  ready_.notify_all();
+  thread_.join();
+  for(size_t i=0; i < blocks_.size(); i++) delete blocks_[i];
+  delete source_;
+}
+
+void asyncSource::run()
+{
+  while ( true )
+    {
+      block* b = 0;
+      {
+        unique_lock<mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return done_ || ! free_.empty(); });
+        if ( done_ ) return;
+        b = free_.front();
+        free_.pop_front();
+      }
+
+      // an empty block marks the end of the source
+      b->size = source_->read(b->data.data(), b->data.size());
+      {
+        lock_guard<mutex> lock(mutex_);
+        full_.push_back(b);
+      }
+      ready_.notify_all();
+      if ( b->size == 0 ) return;
+    }
+}
+
+size_t asyncSource::read(char* buffer, size_t size)
+{
+  if ( eof_ ) return 0;
+
+  if ( current_ == 0 )
+    {
+      unique_lock<mutex> lock(mutex_);
+      ready_.wait(lock, [this]() { return ! full_.empty(); });
+      current_ = full_.front();
+      full_.pop_front();
+      pos_ = 0;
+    }
+  if ( current_->size == 0 )
+    {
+      eof_  = true;
+      good_ = source_->good();
+      return 0;
+    }
+
+  size_t n = current_->size - pos_;
+  if ( n > size ) n = size;
+  memcpy(buffer, current_->data.data() + pos_, n);
+  pos_ += n;
+
+  if ( pos_ >= current_->size )
+    {
+      {
+        lock_guard<mutex> lock(mutex_);
+        free_.push_back(current_);
+      }
+      current_ = 0;
+      ready_.notify_all();
+    }
+  return n;
+}
+
+// -----------------------------------------------------------------------------
+string compression(string filename)
+{
+  // peek only at regular files, since reading consumes a pipe
+  struct stat info;
+  if ( stat(filename.c_str(), &info) != 0 || ! S_ISREG(info.st_mode) )
+    return "";
+
+  unsigned char magic[6] = {0, 0, 0, 0, 0, 0};
+  FILE* f = fopen(filename.c_str(), "rb");
+  if ( f == 0 ) return "";
+  size_t n = fread(magic, 1, sizeof(magic), f);
+  fclose(f);
+
+  if ( n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b )
+    return "gzip";
+  if ( n >= 6 && memcmp(magic, "\xfd" "7zXZ\0", 6) == 0 )
+    return "xz";
+  if ( n >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 &&
+       magic[2] == 0x2f && magic[3] == 0xfd )
+    return "zstd";
+  return "";
+}
+
+hepmcSource* openSource(string filename, int nthreads)
+{
+  string format = compression(filename);
+  if ( format == "" ) return new fileSource(filename);
+
+  hepmcSource* source = 0;
+#ifdef HAVE_ZLIB
+  if ( format == "gzip" ) source = new gzipSource(filename);
+#endif
+#ifdef HAVE_LZMA
+  if ( format == "xz" ) source = new xzSource(filename);
+#endif
+#ifdef HAVE_ZSTD
+  if ( format == "zstd" )
+    {
+      if ( nthreads > 1 )
+        {
+          zstdFrameSource* frames = new zstdFrameSource(filename, nthreads);
+          if ( frames->good() && frames->frames() > 1 )
+            source = frames;
+          else
+            delete frames;
+        }
+      if ( source == 0 ) source = new zstdSource(filename);
+    }
+#endif
+  if ( source == 0 )
+    {
+      cerr << "** hepmcSource: " << filename << " is " << format
+           << " compressed, but the converter was built without "
+           << format << " support" << endl;
+      return 0;
+    }
+
+  // decompress on a separate thread
+  return new asyncSource(source);
+}
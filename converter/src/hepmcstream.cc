@@ -0,0 +1,133 @@
+// -----------------------------------------------------------------------------
+// File: hepmcstream.cc
+// Description: buffered input stream of HepMC events
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstring>
+#include <iostream>
+#include "hepmcstream.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+hepmcStream::hepmcStream(string filename, size_t bufsize)
+  : hepmcInput(),
+    source_(new fileSource(filename)),
+    eof_(false),
+    buffer_(vector<char>(bufsize)),
+    start_(0),
+    size_(0)
+{
+  init(filename);
+}
+
+hepmcStream::hepmcStream(hepmcSource* source, string filename, size_t bufsize)
+  : hepmcInput(),
+    source_(source),
+    eof_(false),
+    buffer_(vector<char>(bufsize)),
+    start_(0),
+    size_(0)
+{
+  init(filename);
+}
+
+void hepmcStream::init(string filename)
+{
+  if ( source_ == 0 || ! source_->good() )
+    {
+      good_ = false;
+      return;
+    }
+
+  // read until we find the first event
+  const char* p = 0;
+  while ( true )
+    {
+      p = findEvent(buffer_.data(), buffer_.data() + size_);
+      if ( p < buffer_.data() + size_ || eof_ ) break;
+      fill();
+    }
+
+  if ( ! decodeHeader(buffer_.data(), p) )
+    {
+      cerr << "** hepmcStream: format problem in file " << filename << endl;
+      good_ = false;
+      return;
+    }
+  start_ = position_ = p - buffer_.data();
+}
+
+hepmcStream::~hepmcStream()
+{
+  if ( source_ ) delete source_;
+}
+
+bool hepmcStream::read(const char*& begin, const char*& end)
+{
+  if ( ! good_ ) return false;
+
+  while ( true )
+    {
+      const char* b = buffer_.data();
+      const char* e = b + size_;
+      const char* p = findEvent(b + start_, e);
+      if ( p < e )
+        {
+          // found start of event, now find its end
+          const char* q = (const char*)memchr(p, '\n', e - p);
+          q = q ? findEvent(q + 1, e) : e;
+          if ( q < e || eof_ )
+            {
+              if ( q == e )
+                {
+                  q = findTrailer(p, e);
+                  trailer_ = string(q, e);
+                }
+              begin  = p;
+              end    = q;
+              start_ = q - b;
+              position_ += q - p;
+              return true;
+            }
+          // event is incomplete
+          start_ = p - b;
+        }
+      else
+        {
+          if ( eof_ )
+            {
+              start_ = size_;
+              return false;
+            }
+          // keep partial line
+          const char* q = (const char*)memrchr(b + start_, '\n', e - b - start_);
+          if ( q ) start_ = q + 1 - b;
+        }
+      fill();
+      if ( ! good_ ) return false;
+    }
+}
+
+bool hepmcStream::fill()
+{
+  char* b = buffer_.data();
+  if ( start_ > 0 )
+    {
+      memmove(b, b + start_, size_ - start_);
+      size_ -= start_;
+      start_ = 0;
+    }
+  if ( size_ == buffer_.size() )
+    {
+      buffer_.resize(2 * buffer_.size());
+      b = buffer_.data();
+    }
+  size_t n = source_->read(b + size_, buffer_.size() - size_);
+  size_ += n;
+  if ( n == 0 )
+    {
+      eof_ = true;
+      if ( ! source_->good() ) good_ = false;
+    }
+  return n > 0;
+}
@@ -0,0 +1,514 @@
+// -----------------------------------------------------------------------------
+// File: hepmctree.cc
+// Description: write the contents of a Bag to the Events tree
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include "TLeaf.h"
+#include "TList.h"
+#include "TNamed.h"
+#include "TObjArray.h"
+#include "TROOT.h"
+#include "hepmcmonitor.h"
+#include "hepmctree.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  /// Return ROOT type name of the given leaflist type.
+  string typeName(string type)
+  {
+    if ( type == "I" ) return "Int_t";
+    if ( type == "D" ) return "Double_t";
+    if ( type == "F" ) return "Float_t";
+    if ( type == "S" ) return "Short_t";
+    if ( type.substr(0, 1) == "f" ) return "Float16_t";
+    return type;
+  }
+}
+
+
+hepmcTree::hepmcTree(string filename, Bag& bag, string version,
+                     string schema, string treename, bool resume)
+  : hepmcOutput(),
+    file_(0),
+    tree_(0),
+    bag_(&bag),
+    flush_(0),
+    bytes_(0),
+    resume_(resume),
+    point_(""),
+    branch_(vector<TBranch*>()),
+    column_(vector<column>()),
+    buffer_(list<vector<char> >()),
+    pidcode_(map<int, int>()),
+    pidtable_(vector<int>())
+{
+  bool compact   = false;
+  bool compact16 = false;
+  bool pidcode   = false;
+  bool vertex    = false;
+  bool kinematics= false;
+  istringstream words(schema);
+  string word;
+  while ( getline(words, word, ',') )
+    {
+      if ( word == "compact" )
+        compact = true;
+      else if ( word == "compact16" )
+        compact = compact16 = true;
+      else if ( word == "pidcode" )
+        pidcode = true;
+      else if ( word == "vertex" )
+        vertex = true;
+      else if ( word == "kinematics" )
+        kinematics = true;
+      else if ( word != "full" )
+        {
+          cerr << "** hepmcTree: unknown schema " << word << endl;
+          good_ = false;
+          return;
+        }
+    }
+  // leaf type of positions and momenta in a compact schema
+  string real(compact16 ? "f[0,0,14]" : "F");
+
+  file_ = new TFile(filename.c_str(), resume ? "update" : "recreate");
+  if ( file_ == 0 || file_->IsZombie() )
+    {
+      cerr << "** hepmcTree: can't open file " << filename << endl;
+      good_ = false;
+      return;
+    }
+
+  file_->cd();
+  if ( resume )
+    {
+      // continue the tree saved by the last checkpoint
+      tree_ = (TTree*)file_->Get(treename.c_str());
+      TObject* point = 0;
+      if ( tree_ ) point = tree_->GetUserInfo()->FindObject("checkpoint");
+      if ( point == 0 )
+        {
+          cerr << "** hepmcTree: no checkpoint of tree " << treename
+               << " in file " << filename << endl;
+          tree_ = 0;
+          good_ = false;
+          return;
+        }
+      point_ = string(point->GetTitle());
+    }
+  else
+    {
+      time_t t = time(0);
+      string now(ctime(&t));
+      now = now.substr(0, now.size()-1); // skip "\n"
+      string title = string("created: ") + now + string(" HepMC ") + version;
+      tree_ = new TTree(treename.c_str(), title.c_str());
+    }
+
+  // the order of branches is that of the fields in the Bag
+  add("Event_number",     &bag.Event_number,     'I');
+  add("Event_numberMP",   &bag.Event_numberMP,   'I');
+  add("Event_scale",      &bag.Event_scale,      'D');
+  add("Event_alphaQCD",   &bag.Event_alphaQCD,   'D');
+  add("Event_alphaQED",   &bag.Event_alphaQED,   'D');
+  add("Event_barcodeSPV", &bag.Event_barcodeSPV, 'I');
+  add("Event_numberV",    &bag.Event_numberV,    'I');
+  add("Event_barcodeBP1", &bag.Event_barcodeBP1, 'I');
+  add("Event_barcodeBP2", &bag.Event_barcodeBP2, 'I');
+  add("Event_numberP",    &bag.Event_numberP,    'I');
+
+  add("Xsection_value",   &bag.Xsection_value,   'D');
+  add("Xsection_error",   &bag.Xsection_error,   'D');
+
+  add("PDF_parton1",      &bag.PDF_parton1,      'I');
+  add("PDF_parton2",      &bag.PDF_parton2,      'I');
+  add("PDF_x1",           &bag.PDF_x1,           'D');
+  add("PDF_x2",           &bag.PDF_x2,           'D');
+  add("PDF_Q2",           &bag.PDF_Q2,           'D');
+  add("PDF_x1f",          &bag.PDF_x1f,          'D');
+  add("PDF_x2f",          &bag.PDF_x2f,          'D');
+  add("PDF_id1",          &bag.PDF_id1,          'I');
+  add("PDF_id2",          &bag.PDF_id2,          'I');
+
+  if ( vertex )
+    add("Particle_vertex", bag.Particle_vertex,   'I');
+  else if ( compact )
+    {
+      add<float>("Particle_x",       bag.Particle_x,       real);
+      add<float>("Particle_y",       bag.Particle_y,       real);
+      add<float>("Particle_z",       bag.Particle_z,       real);
+      add<float>("Particle_ctau",    bag.Particle_ctau,    real);
+    }
+  else
+    {
+      add("Particle_x",       bag.Particle_x,        'D');
+      add("Particle_y",       bag.Particle_y,        'D');
+      add("Particle_z",       bag.Particle_z,        'D');
+      add("Particle_ctau",    bag.Particle_ctau,     'D');
+    }
+
+  if ( compact )
+    {
+      add<int>("Particle_barcode",   bag.Particle_barcode, "I");
+      if ( pidcode )
+        addPidcode();
+      else
+        add("Particle_pid",          bag.Particle_pid,     'I');
+      add<float>("Particle_px",      bag.Particle_px,      real);
+      add<float>("Particle_py",      bag.Particle_py,      real);
+      add<float>("Particle_pz",      bag.Particle_pz,      real);
+      add<float>("Particle_energy",  bag.Particle_energy,  real);
+      add<float>("Particle_mass",    bag.Particle_mass,    real);
+      add<short>("Particle_status",  bag.Particle_status,  "S");
+    }
+  else
+    {
+      add("Particle_barcode", bag.Particle_barcode,  'D');
+      if ( pidcode )
+        addPidcode();
+      else
+        add("Particle_pid",   bag.Particle_pid,      'I');
+      add("Particle_px",      bag.Particle_px,       'D');
+      add("Particle_py",      bag.Particle_py,       'D');
+      add("Particle_pz",      bag.Particle_pz,       'D');
+      add("Particle_energy",  bag.Particle_energy,   'D');
+      add("Particle_mass",    bag.Particle_mass,     'D');
+      add("Particle_status",  bag.Particle_status,   'I');
+    }
+  if ( kinematics && compact )
+    {
+      add<float>("Particle_pt",       bag.Particle_pt,       real);
+      add<float>("Particle_eta",      bag.Particle_eta,      real);
+      add<float>("Particle_phi",      bag.Particle_phi,      real);
+      add<float>("Particle_rapidity", bag.Particle_rapidity, real);
+    }
+  else if ( kinematics )
+    {
+      add("Particle_pt",       bag.Particle_pt,       'D');
+      add("Particle_eta",      bag.Particle_eta,      'D');
+      add("Particle_phi",      bag.Particle_phi,      'D');
+      add("Particle_rapidity", bag.Particle_rapidity, 'D');
+    }
+  add("Particle_d1",      bag.Particle_d1,       'I');
+  add("Particle_d2",      bag.Particle_d2,       'I');
+
+  add("Particle_m1",      bag.Particle_m1,       'I');
+  add("Particle_m2",      bag.Particle_m2,       'I');
+
+  add("Event_numberD",    &bag.Event_numberD,    'I');
+  add("Particle_doffset", bag.Particle_doffset,  'I');
+  add("Daughter_index",   bag.Daughter_index,    'I', "Event_numberD");
+
+  add("Event_numberM",    &bag.Event_numberM,    'I');
+  add("Particle_moffset", bag.Particle_moffset,  'I');
+  add("Mother_index",     bag.Mother_index,      'I', "Event_numberM");
+
+  if ( vertex )
+    {
+      add("Event_numberVX",   &bag.Event_numberVX,   'I');
+      add("Vertex_barcode",   bag.Vertex_barcode,    'I', "Event_numberVX");
+      if ( compact )
+        {
+          add<float>("Vertex_x",    bag.Vertex_x,    real, "Event_numberVX");
+          add<float>("Vertex_y",    bag.Vertex_y,    real, "Event_numberVX");
+          add<float>("Vertex_z",    bag.Vertex_z,    real, "Event_numberVX");
+          add<float>("Vertex_ctau", bag.Vertex_ctau, real, "Event_numberVX");
+        }
+      else
+        {
+          add("Vertex_x",       bag.Vertex_x,          'D', "Event_numberVX");
+          add("Vertex_y",       bag.Vertex_y,          'D', "Event_numberVX");
+          add("Vertex_z",       bag.Vertex_z,          'D', "Event_numberVX");
+          add("Vertex_ctau",    bag.Vertex_ctau,       'D', "Event_numberVX");
+        }
+    }
+
+  // a resumed tree must have been written with the same schema
+  if ( resume && good_ &&
+       tree_->GetListOfBranches()->GetEntries() != (int)branch_.size() )
+    {
+      cerr << "** hepmcTree: tree " << treename
+           << " was written with another schema" << endl;
+      good_ = false;
+    }
+  if ( resume && ! good_ ) tree_ = 0; // leave the file as it is
+}
+
+hepmcTree::~hepmcTree()
+{
+  close();
+}
+
+void hepmcTree::add(string name, void* address, string type, string count)
+{
+  string fmt = name;
+  if ( count != "" ) fmt += string("[") + count + string("]");
+  fmt += string("/") + type;
+  if ( ! resume_ )
+    {
+      branch_.push_back(tree_->Branch(name.c_str(), address, fmt.c_str()));
+      return;
+    }
+
+  TBranch* b = tree_->GetBranch(name.c_str());
+  if ( b == 0 )
+    {
+      if ( good_ )
+        cerr << "** hepmcTree: branch " << name << " not found; the tree "
+             << "was written with another schema" << endl;
+      good_ = false;
+      b = tree_->Branch(name.c_str(), address, fmt.c_str());
+    }
+
+  // the schemas share branch names, so the type and the length of the
+  // saved leaf must also be those asked for; otherwise the buffers given
+  // to SetAddress would not match the entries appended
+  TObjArray* leaves = b->GetListOfLeaves();
+  TLeaf* leaf = leaves ? (TLeaf*)leaves->At(0) : 0;
+  TLeaf* length = leaf ? leaf->GetLeafCount() : 0;
+  string saved = leaf ? typeName(leaf->GetTypeName()) : string("");
+  string savedcount = length ? string(length->GetName()) : string("");
+  if ( good_ && (saved != typeName(type) || savedcount != count) )
+    {
+      cerr << "** hepmcTree: branch " << name << " was written as "
+           << saved << (savedcount != "" ? "[" + savedcount + "]" : "")
+           << ", not " << typeName(type)
+           << (count != "" ? "[" + count + "]" : "")
+           << "; the tree was written with another schema" << endl;
+      good_ = false;
+    }
+  b->SetAddress(address);
+  branch_.push_back(b);
+}
+
+template <class T>
+void hepmcTree::add(string name, vector<T>& array, char type, string count)
+{
+  add(name, array.data(), type, count);
+  column c = {branch_.back(), [&array]() { return (void*)array.data(); },
+              array.data(), std::function<void()>()};
+  column_.push_back(c);
+}
+
+template <class U, class T>
+void hepmcTree::add(string name, vector<T>& array, string type, string count)
+{
+  buffer_.push_back(vector<char>(array.size() * sizeof(U)));
+  vector<char>& buffer = buffer_.back();
+  add(name, buffer.data(), type, count);
+
+  int* n = counter(count);
+  column c = {branch_.back(), [&buffer]() { return (void*)buffer.data(); },
+              buffer.data(),
+              [&array, &buffer, n]()
+              {
+                if ( buffer.size() < array.size() * sizeof(U) )
+                  buffer.resize(array.size() * sizeof(U));
+                U* values = (U*)buffer.data();
+                for(int i=0; i < *n; i++) values[i] = (U)array[i];
+              }};
+  column_.push_back(c);
+}
+
+int* hepmcTree::counter(string count)
+{
+  if ( count == "Event_numberD" )  return &bag_->Event_numberD;
+  if ( count == "Event_numberM" )  return &bag_->Event_numberM;
+  if ( count == "Event_numberVX" ) return &bag_->Event_numberVX;
+  return &bag_->Event_numberP;
+}
+
+void hepmcTree::addPidcode()
+{
+  vector<int>& pid = bag_->Particle_pid;
+  buffer_.push_back(vector<char>(pid.size() * sizeof(short)));
+  vector<char>& buffer = buffer_.back();
+  add("Particle_pidcode", buffer.data(), 'S', "Event_numberP");
+
+  // a resumed tree continues the codes assigned so far
+  TTree* table = resume_ ? (TTree*)file_->Get("Particle_pidtable") : 0;
+  if ( table )
+    {
+      int pid = 0;
+      table->SetBranchAddress("pid", &pid);
+      for(Long64_t entry=0; entry < table->GetEntries(); entry++)
+        {
+          table->GetEntry(entry);
+          pidcode_[pid] = (int)pidtable_.size();
+          pidtable_.push_back(pid);
+        }
+      delete table;
+    }
+
+  column c = {branch_.back(), [&buffer]() { return (void*)buffer.data(); },
+              buffer.data(),
+              [this, &pid, &buffer]()
+              {
+                if ( buffer.size() < pid.size() * sizeof(short) )
+                  buffer.resize(pid.size() * sizeof(short));
+                short* code = (short*)buffer.data();
+                for(int i=0; i < bag_->Event_numberP; i++)
+                  {
+                    map<int, int>::iterator it = pidcode_.find(pid[i]);
+                    if ( it == pidcode_.end() )
+                      {
+                        if ( pidtable_.size() > 32766 )
+                          {
+                            if ( good_ )
+                              cerr << "** hepmcTree: too many PDG ids for "
+                                   << "Particle_pidcode" << endl;
+                            good_ = false;
+                            code[i] = -1;
+                            continue;
+                          }
+                        it = pidcode_.insert(make_pair(pid[i],
+                                                       (int)pidtable_.size()))
+                          .first;
+                        pidtable_.push_back(pid[i]);
+                      }
+                    code[i] = it->second;
+                  }
+              }};
+  column_.push_back(c);
+}
+
+void hepmcTree::setThreads(int n)
+{
+  if ( n < 2 ) return;
+  if ( ! ROOT::IsImplicitMTEnabled() ) ROOT::EnableImplicitMT(n);
+  tree_->SetImplicitMT(true);
+}
+
+void hepmcTree::setCompression(int settings)
+{
+  file_->SetCompressionSettings(settings);
+  for(size_t c=0; c < branch_.size(); c++)
+    branch_[c]->SetCompressionSettings(settings);
+}
+
+void hepmcTree::setFlush(long long n)
+{
+  flush_ = n;
+  if ( flush_ > 0 ) tree_->SetAutoFlush(flush_);
+}
+
+void hepmcTree::fill()
+{
+  // the arrays move when the bag grows
+  for(size_t c=0; c < column_.size(); c++)
+    {
+      if ( column_[c].convert ) column_[c].convert();
+      void* address = column_[c].address();
+      if ( address != column_[c].current )
+        {
+          column_[c].branch->SetAddress(address);
+          column_[c].current = address;
+        }
+    }
+  // the baskets are compressed and written as they fill up
+  double t = seconds();
+  file_->cd();
+  tree_->Fill();
+  if ( flush_ > 0 && tree_->GetEntries() % flush_ == 0 )
+    tree_->AutoSave("SaveSelf");
+  write_ += seconds() - t;
+}
+
+bool hepmcTree::checkpoint(string point)
+{
+  if ( tree_ == 0 ) return false;
+  file_->cd();
+
+  // the table is written first, so that it covers the codes of the
+  // entries saved
+  writePidtable();
+
+  // the resume point is saved with the tree header, so that the two
+  // always agree
+  tree_->SetAutoSave(0);
+  TList* info = tree_->GetUserInfo();
+  TObject* old = info->FindObject("checkpoint");
+  if ( old )
+    {
+      info->Remove(old);
+      delete old;
+    }
+  info->Add(new TNamed("checkpoint", point.c_str()));
+  double t = seconds();
+  tree_->AutoSave("SaveSelf;FlushBaskets");
+  write_ += seconds() - t;
+  return true;
+}
+
+void hepmcTree::writePidtable()
+{
+  if ( tree_->GetBranch("Particle_pidcode") == 0 ) return;
+  TTree* table = new TTree("Particle_pidtable",
+                           "PDG id of each Particle_pidcode");
+  int pid = 0;
+  table->Branch("pid", &pid, "pid/I");
+  for(size_t code=0; code < pidtable_.size(); code++)
+    {
+      pid = pidtable_[code];
+      table->Fill();
+    }
+  table->Write("", TObject::kOverwrite);
+  delete table;
+}
+
+void hepmcTree::close()
+{
+  if ( file_ == 0 ) return;
+  double t = seconds();
+  if ( tree_ )
+    {
+      // a complete tree has no resume point
+      TList* info = tree_->GetUserInfo();
+      TObject* point = info->FindObject("checkpoint");
+      if ( point )
+        {
+          info->Remove(point);
+          delete point;
+        }
+      file_->cd();
+      tree_->Write("", TObject::kOverwrite);
+      writePidtable();
+    }
+  file_->Close();
+  bytes_ = file_->GetBytesWritten();
+  delete file_;
+  file_ = 0;
+  tree_ = 0;
+  write_ += seconds() - t;
+}
+
+long long hepmcTree::entries()
+{
+  return tree_ ? tree_->GetEntries() : 0;
+}
+
+long long hepmcTree::bytes()
+{
+  return file_ ? file_->GetBytesWritten() : bytes_;
+}
+
+void hepmcTree::ls()
+{
+  for(size_t ii=0; ii < branch_.size(); ii++)
+    {
+      TBranch* b = branch_[ii];
+      TObjArray* leaves = b->GetListOfLeaves();
+      TLeaf* leaf = leaves ? (TLeaf*)leaves->At(0) : 0;
+      if ( leaf == 0 )
+        {
+          cerr << "** hepmcTree: no leaf found for branch "
+               << b->GetName() << endl;
+          continue;
+        }
+      printf("%4d\t%-20s\t%s\n", (int)ii+1, b->GetName(), leaf->GetTypeName());
+    }
+}
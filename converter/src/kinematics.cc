@@ -0,0 +1,58 @@
+// -----------------------------------------------------------------------------
+// File: kinematics.cc
+// Description: compute the derived kinematic variables of particles
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cmath>
+#include "kinematics.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  // value of eta along the beam axis, as in TVector3::PseudoRapidity
+  const double AXIS = 10e10;
+}
+
+void computeKinematics(Bag& bag)
+{
+  computeKinematics(bag.Particle_px.data(), bag.Particle_py.data(),
+                    bag.Particle_pz.data(), bag.Particle_energy.data(),
+                    bag.Particle_pt.data(), bag.Particle_eta.data(),
+                    bag.Particle_phi.data(), bag.Particle_rapidity.data(),
+                    bag.Event_numberP);
+}
+
+void computeKinematics(const double* px, const double* py, const double* pz,
+                       const double* energy,
+                       double* pt, double* eta, double* phi, double* rapidity,
+                       int n)
+{
+  // the loops are kept short, so that the compiler can check at run time
+  // that the arrays do not overlap and vectorize them
+  for(int i=0; i < n; i++)
+    pt[i] = sqrt(px[i] * px[i] + py[i] * py[i]);
+
+  // the arguments of the logarithms; a division by zero gives an infinity
+  // or a NaN, which is replaced below
+  for(int i=0; i < n; i++)
+    eta[i] = (sqrt(pt[i] * pt[i] + pz[i] * pz[i]) + fabs(pz[i])) / pt[i];
+  for(int i=0; i < n; i++)
+    rapidity[i] = (energy[i] + fabs(pz[i])) / (energy[i] - fabs(pz[i]));
+
+  for(int i=0; i < n; i++) eta[i] = log(eta[i]);
+  for(int i=0; i < n; i++) rapidity[i] = log(rapidity[i]);
+
+  for(int i=0; i < n; i++)
+    {
+      double sign = pz[i] < 0 ? -1 : 1;
+      double axis = pz[i] == 0 ? 0 : sign * AXIS;
+      eta[i] = pt[i] > 0 ? sign * eta[i] : axis;
+    }
+  for(int i=0; i < n; i++)
+    {
+      double sign = pz[i] < 0 ? -1 : 1;
+      double axis = pz[i] == 0 ? 0 : sign * AXIS;
+      rapidity[i] = energy[i] > fabs(pz[i]) ? sign * 0.5 * rapidity[i] : axis;
+    }
+
+  for(int i=0; i < n; i++) phi[i] = atan2(py[i], px[i]);
+}
@@ -0,0 +1,110 @@
+// -----------------------------------------------------------------------------
+// File: particleselection.cc
+// Description: select the particles to be kept at conversion time
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <charconv>
+#include <iostream>
+#include "particleselection.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+particleSelection::particleSelection(string expression)
+  : good_(true),
+    alternative_(vector<vector<criterion> >(1))
+{
+  for(size_t i=0; i < expression.size(); i++)
+    if ( expression[i] == ';' || expression[i] == '\t' ) expression[i] = ' ';
+
+  size_t i = 0;
+  while ( i < expression.size() )
+    {
+      size_t j = expression.find(' ', i);
+      if ( j == string::npos ) j = expression.size();
+      string word = expression.substr(i, j - i);
+      i = j + 1;
+      if ( word == "" ) continue;
+
+      if ( word == "or" )
+        {
+          if ( alternative_.back().empty() ) good_ = false;
+          alternative_.push_back(vector<criterion>());
+          continue;
+        }
+      criterion c;
+      if ( ! decode(word, c) )
+        {
+          cerr << "** particleSelection: can't decode " << word << endl;
+          good_ = false;
+          continue;
+        }
+      alternative_.back().push_back(c);
+    }
+  if ( alternative_.back().empty() )
+    {
+      cerr << "** particleSelection: empty selection in "
+           << expression << endl;
+      good_ = false;
+    }
+}
+
+particleSelection::~particleSelection() {}
+
+bool particleSelection::decode(string word, criterion& c)
+{
+  size_t k = word.find_first_of("=<>");
+  if ( k == string::npos ) return false;
+  string name = word.substr(0, k);
+  string op = word.substr(k, word[k+1] == '=' ? 2 : 1);
+  const char* p   = word.c_str() + k + op.size();
+  const char* end = word.c_str() + word.size();
+
+  if ( name == "pt" )
+    {
+      c.variable = PT;
+      if ( op == "<" )
+        c.op = LT;
+      else if ( op == "<=" )
+        c.op = LE;
+      else if ( op == ">" )
+        c.op = GT;
+      else if ( op == ">=" )
+        c.op = GE;
+      else
+        return false;
+      double x = 0;
+      from_chars_result r = from_chars(p, end, x);
+      if ( r.ec != errc() || r.ptr != end ) return false;
+      c.cut = x < 0 ? -x * x : x * x;
+      return true;
+    }
+
+  if ( name == "status" )
+    c.variable = STATUS;
+  else if ( name == "pid" )
+    c.variable = PID;
+  else if ( name == "|pid|" )
+    c.variable = ABSPID;
+  else
+    return false;
+  if ( op != "=" ) return false;
+
+  // list of values and ranges, e.g., 1,21-29
+  while ( p < end )
+    {
+      int first = 0;
+      from_chars_result r = from_chars(p, end, first);
+      if ( r.ec != errc() ) return false;
+      int last = first;
+      p = r.ptr;
+      if ( p < end && *p == '-' )
+        {
+          r = from_chars(p + 1, end, last);
+          if ( r.ec != errc() ) return false;
+          p = r.ptr;
+        }
+      c.range.push_back(make_pair(first, last));
+      if ( p < end && *p++ != ',' ) return false;
+    }
+  return ! c.range.empty();
+}
@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------------------
+// File: rangewriter.cc
+// Description: write byte ranges to a file without copying them
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include <cerrno>
+#include <climits>
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "rangewriter.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+namespace {
+  // flush when this many bytes are queued
+  const size_t MAXQUEUED = 1 << 26;
+
+#ifdef IOV_MAX
+  const size_t MAXIOV = IOV_MAX;
+#else
+  const size_t MAXIOV = 1024;
+#endif
+}
+
+rangeWriter::rangeWriter(string filename)
+  : good_(true),
+    fd_(open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+    source_(-1),
+    data_(0),
+    size_(0),
+    bytes_(0),
+    queued_(0),
+    range_(vector<pair<const char*, size_t> >())
+{
+  if ( fd_ < 0 )
+    {
+      cerr << "** rangeWriter: can't open file " << filename << endl;
+      good_ = false;
+    }
+}
+
+rangeWriter::~rangeWriter()
+{
+  close();
+}
+
+void rangeWriter::setSource(int fd, const char* data, size_t size)
+{
+  source_ = fd;
+  data_   = data;
+  size_   = size;
+}
+
+void rangeWriter::write(const char* begin, const char* end)
+{
+  size_t n = end - begin;
+  if ( n == 0 ) return;
+
+  // the records of consecutive events are adjacent
+  if ( ! range_.empty() &&
+       range_.back().first + range_.back().second == begin )
+    range_.back().second += n;
+  else
+    range_.push_back(make_pair(begin, n));
+  queued_ += n;
+  if ( queued_ >= MAXQUEUED || range_.size() >= MAXIOV ) flush();
+}
+
+void rangeWriter::flush()
+{
+  // write runs of ranges outside the source with writev, and copy the
+  // others from the source
+  size_t i = 0;
+  while ( i < range_.size() && good_ )
+    {
+      if ( inSource(range_[i].first, range_[i].second) )
+        {
+          copyRange(range_[i].first, range_[i].second);
+          i++;
+          continue;
+        }
+      size_t j = i;
+      while ( j < range_.size() &&
+              ! inSource(range_[j].first, range_[j].second) ) j++;
+      writeRanges(i, j);
+      i = j;
+    }
+  range_.clear();
+  queued_ = 0;
+}
+
+void rangeWriter::writeRanges(size_t first, size_t last)
+{
+  vector<iovec> iov(last - first);
+  for(size_t i=first; i < last; i++)
+    {
+      iov[i-first].iov_base = (void*)range_[i].first;
+      iov[i-first].iov_len  = range_[i].second;
+    }
+
+  size_t k = 0;
+  while ( k < iov.size() )
+    {
+      ssize_t n = writev(fd_, &iov[k], (int)(iov.size() - k));
+      if ( n < 0 )
+        {
+          if ( errno == EINTR ) continue;
+          cerr << "** rangeWriter: write failed" << endl;
+          good_ = false;
+          return;
+        }
+      bytes_ += n;
+
+      // skip what was written, which may end within a range
+      while ( k < iov.size() && (size_t)n >= iov[k].iov_len )
+        n -= iov[k++].iov_len;
+      if ( k < iov.size() )
+        {
+          iov[k].iov_base = (char*)iov[k].iov_base + n;
+          iov[k].iov_len -= n;
+        }
+    }
+}
+
+void rangeWriter::copyRange(const char* p, size_t n)
+{
+#ifdef __linux__
+  loff_t offset = p - data_;
+  while ( n > 0 )
+    {
+      ssize_t m = copy_file_range(source_, &offset, fd_, 0, n, 0);
+      if ( m <= 0 )
+        {
+          if ( m < 0 && errno == EINTR ) continue;
+          // e.g., across file systems on older kernels: from now on,
+          // write from the mapping
+          source_ = -1;
+          break;
+        }
+      bytes_ += m;
+      p += m;
+      n -= m;
+    }
+  if ( n == 0 ) return;
+#endif
+  range_.push_back(make_pair(p, n));
+  writeRanges(range_.size() - 1, range_.size());
+  range_.pop_back();
+}
+
+void rangeWriter::close()
+{
+  if ( fd_ < 0 ) return;
+  flush();
+  if ( ::close(fd_) != 0 ) good_ = false;
+  fd_ = -1;
+}
@@ -0,0 +1,44 @@
+// -----------------------------------------------------------------------------
+// File: threadpool.cc
+// Description: a fixed set of worker threads
+// Created: 16-Oct-2026 HBP
+// -----------------------------------------------------------------------------
+#include "threadpool.h"
+using namespace std;
+// -----------------------------------------------------------------------------
+
+threadPool::threadPool(int nthreads)
+  : workers_(vector<thread>()),
+    tasks_(deque<function<void()> >()),
+    done_(false)
+{
+  if ( nthreads < 1 ) nthreads = 1;
+  for(int i=0; i < nthreads; i++)
+    workers_.push_back(thread(&threadPool::run, this));
+}
+
+threadPool::~threadPool()
+{
+  {
+    lock_guard<mutex> lock(mutex_);
+    done_ = true;
+  }
+  ready_.notify_all();
+  for(size_t i=0; i < workers_.size(); i++) workers_[i].join();
+}
+
+void threadPool::run()
+{
+  while ( true )
+    {
+      function<void()> task;
+      {
+        unique_lock<mutex> lock(mutex_);
+        ready_.wait(lock, [this]() { return done_ || ! tasks_.empty(); });
+        if ( tasks_.empty() ) return;
+        task = tasks_.front();
+        tasks_.pop_front();
+      }
+      task();
+    }
+}
@@ -0,0 +1,135 @@
+# -----------------------------------------------------------------------
+# File: hepmcpandas.py
+# Description: read the events of a HepMC file into pandas DataFrames a
+#              chunk at a time. The events are parsed by the compiled
+#              converter (converter/lib/libhepmccolumns.so, built with
+#              "make pylib" in the converter directory) straight into typed
+#              columns, which are copied once into numpy arrays. Each chunk
+#              gives two DataFrames: events, with one row per event, and
+#              particles, with one row per particle and the event number
+#              Event_number as key. Particle_name is a categorical whose
+#              categories are the names in pnames.py. With kinematics=True
+#              the particles also have the columns Particle_pt,
+#              Particle_eta, Particle_phi and Particle_rapidity.
+#
+#              from hepmcpandas import hepmcChunks
+#              for events, particles in hepmcChunks('susy200.hepmc', 1000):
+#                  ...
+#
+# Created: 16-Oct-2026 HBP
+# -----------------------------------------------------------------------
+import os, sys, ctypes
+import numpy as np
+import pandas as pd
+from pnames import PDGNAME
+# -----------------------------------------------------------------------
+LIBNAME = 'libhepmccolumns'
+EVENTS, PARTICLES = 0, 1
+DTYPE = {b'i': np.int32, b'd': np.float64}
+
+# the categories of Particle_name and, for each known PDG id, in
+# increasing order, the code of its name
+PARTICLE_NAMES = sorted(set(PDGNAME.values())) + ['noname']
+_PIDS  = np.array(sorted(PDGNAME), dtype=np.int32)
+_CODES = np.array([PARTICLE_NAMES.index(PDGNAME[pid]) for pid in _PIDS],
+                      dtype=np.int16)
+_NONAME= len(PARTICLE_NAMES) - 1
+
+def particleNames(pid):
+    """Return a categorical of the names of the PDG ids in array pid."""
+    i = np.searchsorted(_PIDS, pid)
+    i[i == len(_PIDS)] = 0
+    codes = np.where(_PIDS[i] == pid, _CODES[i], _NONAME)
+    return pd.Categorical.from_codes(codes, categories=PARTICLE_NAMES)
+
+def loadLibrary():
+    dirs = []
+    if 'HEPMC2ROOT_PATH' in os.environ:
+        dirs.append(os.path.join(os.environ['HEPMC2ROOT_PATH'],
+                                     'converter', 'lib'))
+    here = os.path.dirname(os.path.abspath(__file__))
+    dirs.append(os.path.join(here, '..', 'converter', 'lib'))
+    for d in dirs:
+        for ext in ['.so', '.dylib']:
+            filename = os.path.join(d, LIBNAME + ext)
+            if not os.path.exists(filename): continue
+            lib = ctypes.CDLL(filename)
+            lib.hepmc_open.restype    = ctypes.c_void_p
+            lib.hepmc_open.argtypes   = [ctypes.c_char_p, ctypes.c_int,
+                                         ctypes.c_int]
+            lib.hepmc_close.argtypes  = [ctypes.c_void_p]
+            lib.hepmc_version.restype = ctypes.c_char_p
+            lib.hepmc_version.argtypes= [ctypes.c_void_p]
+            lib.hepmc_read.restype    = ctypes.c_long
+            lib.hepmc_read.argtypes   = [ctypes.c_void_p, ctypes.c_long]
+            lib.hepmc_columns.argtypes= [ctypes.c_void_p]
+            lib.hepmc_name.restype    = ctypes.c_char_p
+            lib.hepmc_name.argtypes   = [ctypes.c_void_p, ctypes.c_int]
+            lib.hepmc_type.restype    = ctypes.c_char
+            lib.hepmc_type.argtypes   = [ctypes.c_void_p, ctypes.c_int]
+            lib.hepmc_table.argtypes  = [ctypes.c_void_p, ctypes.c_int]
+            lib.hepmc_rows.restype    = ctypes.c_long
+            lib.hepmc_rows.argtypes   = [ctypes.c_void_p, ctypes.c_int]
+            lib.hepmc_copy.argtypes   = [ctypes.c_void_p, ctypes.c_int,
+                                             ctypes.c_void_p]
+            return lib
+    sys.exit("** hepmcpandas: can't find %s; do make pylib in converter"
+                 % LIBNAME)
+
+class hepmcChunks:
+
+    def __init__(self, filename, chunksize=10000, nthreads=1,
+                 kinematics=False):
+        if not os.path.exists(filename) and filename != '-':
+            sys.exit("** hepmcpandas: can't open file %s" % filename)
+        self.lib = loadLibrary()
+        self.handle = self.lib.hepmc_open(filename.encode(), nthreads,
+                                            int(kinematics))
+        if not self.handle:
+            sys.exit("** hepmcpandas: can't read file %s" % filename)
+        self.chunksize = chunksize
+        self.version = self.lib.hepmc_version(self.handle).decode()
+
+        lib, h = self.lib, self.handle
+        self.columns = []
+        for c in range(lib.hepmc_columns(h)):
+            self.columns.append((c,
+                                 lib.hepmc_name(h, c).decode(),
+                                 DTYPE[lib.hepmc_type(h, c)],
+                                 lib.hepmc_table(h, c)))
+
+    def __del__(self):
+        self.close()
+
+    def close(self):
+        if getattr(self, 'handle', None):
+            self.lib.hepmc_close(self.handle)
+            self.handle = None
+
+    def __iter__(self):
+        return self
+
+    def __next__(self):
+        lib, h = self.lib, self.handle
+        if not h: raise StopIteration
+        n = lib.hepmc_read(h, self.chunksize)
+        if n < 0:
+            sys.exit("** hepmcpandas: faulty event record")
+        if n == 0:
+            self.close()
+            raise StopIteration
+
+        tables = [{}, {}]
+        rows   = [lib.hepmc_rows(h, EVENTS), lib.hepmc_rows(h, PARTICLES)]
+        for c, name, dtype, table in self.columns:
+            values = np.empty(rows[table], dtype=dtype)
+            lib.hepmc_copy(h, c, values.ctypes.data_as(ctypes.c_void_p))
+            tables[table][name] = values
+            if name == 'Event_number' and table == PARTICLES:
+                tables[table]['Particle_name'] = None # keep column order
+        particles = tables[PARTICLES]
+        particles['Particle_name'] = particleNames(particles['Particle_pid'])
+        return (pd.DataFrame(tables[EVENTS], copy=False),
+                pd.DataFrame(particles, copy=False))
+
+    next = __next__ # Python 2